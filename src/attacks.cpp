@@ -0,0 +1,193 @@
+#include "attacks.h"
+#include "bitboard.h"
+#include <initializer_list>
+#include <utility>
+
+Magic bishopMagics[64];
+Magic rookMagics[64];
+uint64_t knightAttackTable[64];
+uint64_t kingAttackTable[64];
+uint64_t pawnAttackTable[2][64];
+uint64_t betweenTable[64][64];
+uint64_t lineTable[64][64];
+
+namespace
+{
+    const int bishopDirs[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    const int rookDirs[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+    // Shared attack storage: sum over all squares of 2^popcount(mask)
+    uint64_t bishopTable[0x1480];
+    uint64_t rookTable[0x19000];
+
+    // Walk each direction until the board edge or the first blocker (inclusive)
+    uint64_t rayAttacks(int square, const int (&directions)[4][2], uint64_t occupied)
+    {
+        uint64_t attacks = 0;
+        int x = square % 8, y = square / 8;
+        for (const auto &dir : directions)
+        {
+            for (int step = 1;; ++step)
+            {
+                int nx = x + dir[0] * step, ny = y + dir[1] * step;
+                if (nx < 0 || nx >= 8 || ny < 0 || ny >= 8)
+                    break;
+                int target = ny * 8 + nx;
+                attacks |= 1ULL << target;
+                if (occupied & (1ULL << target))
+                    break;
+            }
+        }
+        return attacks;
+    }
+
+    uint64_t stepAttacks(int square, std::initializer_list<std::pair<int, int>> steps)
+    {
+        uint64_t attacks = 0;
+        int x = square % 8, y = square / 8;
+        for (auto [dx, dy] : steps)
+        {
+            int nx = x + dx, ny = y + dy;
+            if (nx >= 0 && nx < 8 && ny >= 0 && ny < 8)
+                attacks |= 1ULL << (ny * 8 + nx);
+        }
+        return attacks;
+    }
+
+    // xorshift64* generator with a fixed seed so magics are identical on every run
+    struct MagicRNG
+    {
+        uint64_t state;
+
+        uint64_t next()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+
+        // Magics with few set bits are found much faster
+        uint64_t sparse() { return next() & next() & next(); }
+    };
+
+    void initMagics(Magic magics[], uint64_t *table, const int (&directions)[4][2])
+    {
+        uint64_t occupancy[4096];
+        uint64_t reference[4096];
+#if !defined(__BMI2__)
+        int epoch[4096] = {};
+        int attempt = 0;
+        MagicRNG rng{0x9E3779B97F4A7C15ULL};
+#endif
+
+        for (int square = 0; square < 64; square++)
+        {
+            Magic &m = magics[square];
+
+            // Edge squares never change the attack set unless the slider stands on that edge
+            uint64_t edges = ((getRankMask(0) | getRankMask(7)) & ~getRankMask(square / 8)) |
+                             ((getFileMask(0) | getFileMask(7)) & ~getFileMask(square % 8));
+
+            m.mask = rayAttacks(square, directions, 0ULL) & ~edges;
+            m.shift = 64 - __builtin_popcountll(m.mask);
+            m.attacks = table;
+
+            // Enumerate every subset of the mask (Carry-Rippler trick)
+            int size = 0;
+            uint64_t subset = 0ULL;
+            do
+            {
+                occupancy[size] = subset;
+                reference[size] = rayAttacks(square, directions, subset);
+                size++;
+                subset = (subset - m.mask) & m.mask;
+            } while (subset);
+
+            table += size;
+
+#if defined(__BMI2__)
+            m.magic = 0ULL;
+            for (int i = 0; i < size; i++)
+                m.attacks[m.index(occupancy[i])] = reference[i];
+#else
+            // Try random candidates until one maps every subset without a destructive collision
+            for (int i = 0; i < size;)
+            {
+                do
+                {
+                    m.magic = rng.sparse();
+                } while (__builtin_popcountll((m.magic * m.mask) >> 56) < 6);
+
+                for (++attempt, i = 0; i < size; i++)
+                {
+                    unsigned idx = m.index(occupancy[i]);
+                    if (epoch[idx] < attempt)
+                    {
+                        epoch[idx] = attempt;
+                        m.attacks[idx] = reference[i];
+                    }
+                    else if (m.attacks[idx] != reference[i])
+                    {
+                        break;
+                    }
+                }
+            }
+#endif
+        }
+    }
+
+    void buildTables()
+    {
+        for (int square = 0; square < 64; square++)
+        {
+            knightAttackTable[square] = stepAttacks(square, {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+                                                             {1, -2}, {1, 2}, {2, -1}, {2, 1}});
+            kingAttackTable[square] = stepAttacks(square, {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
+                                                           {0, 1}, {1, -1}, {1, 0}, {1, 1}});
+            pawnAttackTable[WHITE][square] = stepAttacks(square, {{-1, 1}, {1, 1}});
+            pawnAttackTable[BLACK][square] = stepAttacks(square, {{-1, -1}, {1, -1}});
+        }
+
+        initMagics(bishopMagics, bishopTable, bishopDirs);
+        initMagics(rookMagics, rookTable, rookDirs);
+
+        for (int a = 0; a < 64; a++)
+        {
+            for (int b = 0; b < 64; b++)
+            {
+                betweenTable[a][b] = 0ULL;
+                lineTable[a][b] = 0ULL;
+                uint64_t ends = (1ULL << a) | (1ULL << b);
+
+                if (a != b && (bishopAttacks(a, 0ULL) & (1ULL << b)))
+                {
+                    lineTable[a][b] = (bishopAttacks(a, 0ULL) & bishopAttacks(b, 0ULL)) | ends;
+                    betweenTable[a][b] = bishopAttacks(a, 1ULL << b) & bishopAttacks(b, 1ULL << a);
+                }
+                else if (a != b && (rookAttacks(a, 0ULL) & (1ULL << b)))
+                {
+                    lineTable[a][b] = (rookAttacks(a, 0ULL) & rookAttacks(b, 0ULL)) | ends;
+                    betweenTable[a][b] = rookAttacks(a, 1ULL << b) & rookAttacks(b, 1ULL << a);
+                }
+            }
+        }
+    }
+} // anonymous namespace
+
+void initAttacks()
+{
+    // Function-local static: built exactly once, thread-safe
+    static const bool initialized = (buildTables(), true);
+    (void)initialized;
+}
+
+uint64_t slidingBishopAttacks(int square, uint64_t occupied)
+{
+    return rayAttacks(square, bishopDirs, occupied);
+}
+
+uint64_t slidingRookAttacks(int square, uint64_t occupied)
+{
+    return rayAttacks(square, rookDirs, occupied);
+}
@@ -0,0 +1,124 @@
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include <cstdint>
+#include "types.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Precomputed attack tables for every piece type.
+ *
+ * Slider attacks use "fancy" magic bitboards: the relevant occupancy of a
+ * square is hashed to an index into a shared attack table, so a lookup is a
+ * mask, a multiply and a shift. When compiled for a BMI2 host the index is
+ * computed with PEXT instead and the magic multiplier is unused.
+ *
+ * The tables are built once by initAttacks(), which is called from the Board
+ * constructor and is safe to call any number of times.
+ */
+void initAttacks();
+
+struct Magic
+{
+    uint64_t mask;     // relevant occupancy (board edges excluded)
+    uint64_t magic;    // multiplier mapping mask subsets to unique indices
+    uint64_t *attacks; // start of this square's slice of the attack table
+    unsigned shift;    // 64 - popcount(mask)
+
+    unsigned index(uint64_t occupied) const
+    {
+#if defined(__BMI2__)
+        return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+        return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+    }
+};
+
+extern Magic bishopMagics[64];
+extern Magic rookMagics[64];
+extern uint64_t knightAttackTable[64];
+extern uint64_t kingAttackTable[64];
+extern uint64_t pawnAttackTable[2][64];
+extern uint64_t betweenTable[64][64];
+extern uint64_t lineTable[64][64];
+
+inline uint64_t knightAttacks(int square)
+{
+    return knightAttackTable[square];
+}
+
+inline uint64_t kingAttacks(int square)
+{
+    return kingAttackTable[square];
+}
+
+// Squares a pawn of colour c on `square` attacks
+inline uint64_t pawnAttacks(Color c, int square)
+{
+    return pawnAttackTable[c][square];
+}
+
+/**
+ * Squares strictly between two squares on a shared rank, file or diagonal;
+ * empty if the squares are not aligned.
+ */
+inline uint64_t betweenBB(int a, int b)
+{
+    return betweenTable[a][b];
+}
+
+/**
+ * The full rank, file or diagonal through two aligned squares (edge to edge);
+ * empty if the squares are not aligned.
+ */
+inline uint64_t lineBB(int a, int b)
+{
+    return lineTable[a][b];
+}
+
+inline uint64_t bishopAttacks(int square, uint64_t occupied)
+{
+    const Magic &m = bishopMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+inline uint64_t rookAttacks(int square, uint64_t occupied)
+{
+    const Magic &m = rookMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+inline uint64_t queenAttacks(int square, uint64_t occupied)
+{
+    return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+}
+
+// Attacks of a non-pawn piece type, resolved at compile time
+template <PieceType Pt>
+inline uint64_t attacksFrom(int square, uint64_t occupied)
+{
+    static_assert(Pt != PAWN, "pawn attacks depend on colour");
+    if constexpr (Pt == KNIGHT)
+        return knightAttacks(square);
+    else if constexpr (Pt == BISHOP)
+        return bishopAttacks(square, occupied);
+    else if constexpr (Pt == ROOK)
+        return rookAttacks(square, occupied);
+    else if constexpr (Pt == QUEEN)
+        return queenAttacks(square, occupied);
+    else
+        return kingAttacks(square);
+}
+
+/**
+ * Reference slider attacks that walk each ray square by square.
+ * Used to build the magic tables and to verify them in tests.
+ */
+uint64_t slidingBishopAttacks(int square, uint64_t occupied);
+uint64_t slidingRookAttacks(int square, uint64_t occupied);
+
+#endif // ATTACKS_H
@@ -0,0 +1,132 @@
+// bench_main.cpp: time-to-depth benchmark for the parallel search
+//
+// Usage: bench [depth] [max-threads]
+//
+// Searches a fixed set of positions to `depth` with 1, 2, 4, 8 and 16 threads
+// (up to max-threads), clearing the transposition table before each search,
+// and reports the speedup of each thread count over a single thread and the
+// fullest the table got (hashfull, permille). Then, single-threaded, reports
+// nodes to the same depth with each selective search feature and lazy
+// evaluation switched off in turn, and with all of them off, along with the
+// share of evaluations that exited lazily.
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include "board.h"
+#include "fen.h"
+#include "search.h"
+#include "tt.h"
+
+namespace
+{
+    const char *BENCH_FENS[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+
+    struct SuiteTotals
+    {
+        double seconds = 0.0;
+        uint64_t nodes = 0;
+        uint64_t evaluations = 0;
+        uint64_t lazyEvaluations = 0;
+        int hashfull = 0; // highest over the positions, permille
+    };
+
+    // Searches every bench position from a cleared transposition table
+    SuiteTotals runSuite(const SearchLimits &limits)
+    {
+        SuiteTotals totals;
+        for (const char *fen : BENCH_FENS)
+        {
+            Board board;
+            setBoardFromFEN(board, fen);
+            TT.clear();
+
+            SearchResult result = search(board, limits);
+            totals.seconds += result.seconds;
+            totals.nodes += result.nodes;
+            totals.evaluations += result.evaluations;
+            totals.lazyEvaluations += result.lazyEvaluations;
+            totals.hashfull = std::max(totals.hashfull, TT.hashfull());
+        }
+        return totals;
+    }
+
+    struct Feature
+    {
+        const char *name;
+        bool SearchLimits::*flag;
+    };
+
+    const Feature FEATURES[] = {
+        {"null move", &SearchLimits::nullMovePruning},
+        {"LMR", &SearchLimits::lateMoveReductions},
+        {"futility", &SearchLimits::futilityPruning},
+        {"reverse futility", &SearchLimits::reverseFutilityPruning},
+        {"check extensions", &SearchLimits::checkExtensions},
+        {"lazy evaluation", &SearchLimits::lazyEvaluation},
+    };
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    int depth = argc > 1 ? std::atoi(argv[1]) : 6;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : 16;
+
+    std::cout << "Time to depth " << depth << " over " << std::size(BENCH_FENS) << " positions\n";
+    std::cout << "threads      time (s)        nodes    Mnps   speedup  hashfull\n";
+
+    double baseline = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        SearchLimits limits;
+        limits.maxDepth = depth;
+        limits.threads = threads;
+        SuiteTotals totals = runSuite(limits);
+        double seconds = totals.seconds;
+        uint64_t nodes = totals.nodes;
+
+        if (threads == 1)
+            baseline = seconds;
+
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(3) << std::setw(14) << seconds
+                  << std::setw(13) << nodes << std::setprecision(2) << std::setw(8) << nodes / seconds / 1e6
+                  << std::setw(9) << baseline / seconds << "x" << std::setw(9) << totals.hashfull << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    std::cout << "\nNodes to depth " << depth << ", one thread\n";
+    std::cout << "disabled                 time (s)        nodes   vs all   lazy evals\n";
+
+    SearchLimits allEnabled;
+    allEnabled.maxDepth = depth;
+    uint64_t reference = 0;
+
+    // Row 0: nothing disabled; rows 1..N: one feature off; last row: all off
+    int rows = static_cast<int>(std::size(FEATURES)) + 2;
+    for (int row = 0; row < rows; row++)
+    {
+        SearchLimits limits = allEnabled;
+        const char *name = row == 0 ? "(none)" : row == rows - 1 ? "(all)" : FEATURES[row - 1].name;
+        for (int i = 0; i < static_cast<int>(std::size(FEATURES)); i++)
+            if (row == rows - 1 || row == i + 1)
+                limits.*FEATURES[i].flag = false;
+
+        SuiteTotals totals = runSuite(limits);
+        if (row == 0)
+            reference = totals.nodes;
+
+        std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(13) << totals.seconds << std::setw(13) << totals.nodes << std::setprecision(2)
+                  << std::setw(8) << static_cast<double>(totals.nodes) / reference << "x" << std::setprecision(1)
+                  << std::setw(12) << 100.0 * totals.lazyEvaluations / std::max<uint64_t>(totals.evaluations, 1) << "%\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    return 0;
+}
@@ -2,6 +2,7 @@
 #define BITBOARD_H
 
 #include <cstdint>
+#include "types.h"
 
 /**
  * Various bitboard utility functions.
@@ -30,6 +31,58 @@ int findLSB(uint64_t bitboard);
  */
 int findMSB(uint64_t bitboard);
 
+// Compile-time masks for the edge files and every rank
+constexpr uint64_t FILE_A_BB = 0x0101010101010101ULL;
+constexpr uint64_t FILE_H_BB = FILE_A_BB << 7;
+
+constexpr uint64_t RANK_1_BB = 0xFFULL;
+constexpr uint64_t RANK_2_BB = RANK_1_BB << 8;
+constexpr uint64_t RANK_3_BB = RANK_1_BB << 16;
+constexpr uint64_t RANK_4_BB = RANK_1_BB << 24;
+constexpr uint64_t RANK_5_BB = RANK_1_BB << 32;
+constexpr uint64_t RANK_6_BB = RANK_1_BB << 40;
+constexpr uint64_t RANK_7_BB = RANK_1_BB << 48;
+constexpr uint64_t RANK_8_BB = RANK_1_BB << 56;
+
+// Square index offsets for one step in each direction
+constexpr int NORTH = 8;
+constexpr int SOUTH = -8;
+constexpr int NORTH_EAST = 9;
+constexpr int NORTH_WEST = 7;
+constexpr int SOUTH_EAST = -7;
+constexpr int SOUTH_WEST = -9;
+
+/**
+ * Shifts every bit one step in direction D, dropping bits that would wrap
+ * around the a/h files.
+ */
+template <int D>
+constexpr uint64_t shift(uint64_t bitboard)
+{
+    if constexpr (D == NORTH)
+        return bitboard << 8;
+    else if constexpr (D == SOUTH)
+        return bitboard >> 8;
+    else if constexpr (D == NORTH_EAST)
+        return (bitboard & ~FILE_H_BB) << 9;
+    else if constexpr (D == NORTH_WEST)
+        return (bitboard & ~FILE_A_BB) << 7;
+    else if constexpr (D == SOUTH_EAST)
+        return (bitboard & ~FILE_H_BB) >> 7;
+    else
+        return (bitboard & ~FILE_A_BB) >> 9;
+}
+
+// Squares attacked by every pawn in `pawns` of colour C
+template <Color C>
+constexpr uint64_t pawnAttacksBB(uint64_t pawns)
+{
+    if constexpr (C == WHITE)
+        return shift<NORTH_EAST>(pawns) | shift<NORTH_WEST>(pawns);
+    else
+        return shift<SOUTH_EAST>(pawns) | shift<SOUTH_WEST>(pawns);
+}
+
 // Example: get rank/file/diagonal masks
 uint64_t getRankMask(int rank);
 uint64_t getFileMask(int file);
@@ -1,4 +1,12 @@
 #include "board.h"
+#include "attacks.h"
+#include "bitboard.h"
+#include "movegen.h"
+#include "pawns.h"
+#include "psqt.h"
+#include "tt.h"
+#include "zobrist.h"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -6,77 +14,40 @@
 #include <initializer_list>
 #include <utility>
 #include <cmath>
-#include <random>
-#include <chrono>
-
-// Static member definitions
-uint64_t Board::zobristTable[12][64];
-uint64_t Board::zobristBlackToMove;
-uint64_t Board::zobristCastling[16];
-uint64_t Board::zobristEnPassant[8];
-
-const std::vector<std::pair<int, int>> bishopDirs = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-const std::vector<std::pair<int, int>> rookDirs = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-
-// Piece-Square Tables for positional evaluation
-const int PAWN_TABLE[64] = {
-    0, 0, 0, 0, 0, 0, 0, 0,
-    50, 50, 50, 50, 50, 50, 50, 50,
-    10, 10, 20, 30, 30, 20, 10, 10,
-    5, 5, 10, 25, 25, 10, 5, 5,
-    0, 0, 0, 20, 20, 0, 0, 0,
-    5, -5, -10, 0, 0, -10, -5, 5,
-    5, 10, 10, -20, -20, 10, 10, 5,
-    0, 0, 0, 0, 0, 0, 0, 0};
-
-const int KNIGHT_TABLE[64] = {
-    -50, -40, -30, -30, -30, -30, -40, -50,
-    -40, -20, 0, 0, 0, 0, -20, -40,
-    -30, 0, 10, 15, 15, 10, 0, -30,
-    -30, 5, 15, 20, 20, 15, 5, -30,
-    -30, 0, 15, 20, 20, 15, 0, -30,
-    -30, 5, 10, 15, 15, 10, 5, -30,
-    -40, -20, 0, 5, 5, 0, -20, -40,
-    -50, -40, -30, -30, -30, -30, -40, -50};
-
-// Helper to initialize bitboard with a given set of squares
-static uint64_t initSquares(std::initializer_list<int> squares)
-{
-    uint64_t bitboard = 0ULL;
-    for (int square : squares)
-    {
-        bitboard |= (1ULL << square);
-    }
-    return bitboard;
-}
-
-// ---------- Board::Move Constructor ----------
-Board::Move::Move()
-    : fromSquare(0), toSquare(0), movedPiece(0), capturedPiece(0),
-      promotedPiece(0), prevCastlingRights(0), prevEntPassantTarget(0),
-      oldHalfmoveClock(0), oldFullmoveCounter(0), isCastling(false),
-      rookFromSquare(-1), rookToSquare(-1)
+#include <limits>
+
+// Castling rights that survive a move touching each square: moving the king
+// or a rook off its home square, or capturing on a rook corner, clears them
+static const uint8_t CASTLING_RIGHTS_MASK[64] = {
+    0b1011, 0b1111, 0b1111, 0b1111, 0b0011, 0b1111, 0b1111, 0b0111, // a1 .. h1
+    0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111,
+    0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111,
+    0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111,
+    0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111,
+    0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111,
+    0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111, 0b1111,
+    0b1110, 0b1111, 0b1111, 0b1111, 0b1100, 0b1111, 0b1111, 0b1101, // a8 .. h8
+};
+
+// Map a signed piece code (+1..+6 White, -1..-6 Black) to a Zobrist table row 0-11
+static inline int zobristIndex(int piece)
 {
+    return piece > 0 ? piece - 1 : -piece + 5;
 }
 
 // ---------- Board Constructor ----------
 Board::Board()
 {
-    // White Pieces
-    whitePawns = initSquares({8, 9, 10, 11, 12, 13, 14, 15});
-    whiteKnights = initSquares({1, 6});
-    whiteBishops = initSquares({2, 5});
-    whiteRooks = initSquares({0, 7});
-    whiteQueen = initSquares({3});
-    whiteKing = initSquares({4});
-
-    // Black Pieces
-    blackPawns = initSquares({48, 49, 50, 51, 52, 53, 54, 55});
-    blackKnights = initSquares({57, 62});
-    blackBishops = initSquares({58, 61});
-    blackRooks = initSquares({56, 63});
-    blackQueen = initSquares({59});
-    blackKing = initSquares({60});
+    // Standard starting position
+    resetBitboards();
+    const int backRank[8] = {4, 2, 3, 5, 6, 3, 2, 4};
+    for (int file = 0; file < 8; file++)
+    {
+        placePiece(backRank[file], file);
+        placePiece(1, 8 + file);
+        placePiece(-1, 48 + file);
+        placePiece(-backRank[file], 56 + file);
+    }
 
     // Other properties
     castlingRights = 0b1111;
@@ -85,60 +56,39 @@ Board::Board()
     fullmoveCounter = 1;
     whiteToMove = true;
 
-    // Initialize Zobrist hashing tables
-    initZobrist();
+    moveHistory.reserve(256);
+
+    // Attack tables are built once; Zobrist keys are compile-time constants
+    initAttacks();
+
+    positionKey = calculatePositionKey();
 }
 
 // ---------- resetBitboards ----------
 void Board::resetBitboards()
 {
-    whitePawns = 0ULL;
-    whiteKnights = 0ULL;
-    whiteBishops = 0ULL;
-    whiteRooks = 0ULL;
-    whiteQueen = 0ULL;
-    whiteKing = 0ULL;
-
-    blackPawns = 0ULL;
-    blackKnights = 0ULL;
-    blackBishops = 0ULL;
-    blackRooks = 0ULL;
-    blackQueen = 0ULL;
-    blackKing = 0ULL;
+    for (int c = WHITE; c <= BLACK; c++)
+        for (int pt = PAWN; pt <= KING; pt++)
+            pieces[c][pt] = 0ULL;
+
+    for (int square = 0; square < 64; square++)
+        pieceOn[square] = 0;
+    occupancy[0] = 0ULL;
+    occupancy[1] = 0ULL;
+    occupied = 0ULL;
+    positionKey = 0ULL;
+    pawnKey = 0ULL;
+    psqt = SCORE_ZERO;
+    phase = 0;
+
+    // Undo records of the old position would show up as repetitions
+    moveHistory.clear();
 }
 
 // ---------- findPiece ----------
 int Board::findPiece(int square) const
 {
-    uint64_t mask = (1ULL << square);
-
-    if (whitePawns & mask)
-        return 1;
-    if (whiteKnights & mask)
-        return 2;
-    if (whiteBishops & mask)
-        return 3;
-    if (whiteRooks & mask)
-        return 4;
-    if (whiteQueen & mask)
-        return 5;
-    if (whiteKing & mask)
-        return 6;
-
-    if (blackPawns & mask)
-        return -1;
-    if (blackKnights & mask)
-        return -2;
-    if (blackBishops & mask)
-        return -3;
-    if (blackRooks & mask)
-        return -4;
-    if (blackQueen & mask)
-        return -5;
-    if (blackKing & mask)
-        return -6;
-
-    return 0;
+    return pieceOn[square];
 }
 
 // ---------- movePiece ----------
@@ -151,97 +101,267 @@ void Board::movePiece(int pieceType, int fromSquare, int toSquare)
 // ---------- placePiece ----------
 void Board::placePiece(int pieceType, int square)
 {
-    uint64_t mask = (1ULL << square);
+    if (pieceType == 0)
+        return;
 
-    switch (pieceType)
-    {
-    case 1:
-        whitePawns |= mask;
-        break;
-    case 2:
-        whiteKnights |= mask;
-        break;
-    case 3:
-        whiteBishops |= mask;
-        break;
-    case 4:
-        whiteRooks |= mask;
-        break;
-    case 5:
-        whiteQueen |= mask;
-        break;
-    case 6:
-        whiteKing |= mask;
-        break;
-    case -1:
-        blackPawns |= mask;
-        break;
-    case -2:
-        blackKnights |= mask;
-        break;
-    case -3:
-        blackBishops |= mask;
-        break;
-    case -4:
-        blackRooks |= mask;
-        break;
-    case -5:
-        blackQueen |= mask;
-        break;
-    case -6:
-        blackKing |= mask;
-        break;
-    default:
-        break;
-    }
+    uint64_t mask = (1ULL << square);
+    positionKey ^= Zobrist.pieces[zobristIndex(pieceType)][square];
+    if (typeOf(pieceType) == PAWN)
+        pawnKey ^= Zobrist.pieces[zobristIndex(pieceType)][square];
+    psqt += PSQT.psq[pieceType + 6][square];
+    phase += PHASE_WEIGHT[typeOf(pieceType)];
+    pieces[colorOf(pieceType)][typeOf(pieceType)] |= mask;
+    pieceOn[square] = static_cast<int8_t>(pieceType);
+    occupancy[colorOf(pieceType)] |= mask;
+    occupied |= mask;
 }
 
 // ---------- removePiece ----------
 void Board::removePiece(int pieceType, int square)
 {
+    if (pieceType == 0)
+        return;
+
     uint64_t mask = ~(1ULL << square);
+    positionKey ^= Zobrist.pieces[zobristIndex(pieceType)][square];
+    if (typeOf(pieceType) == PAWN)
+        pawnKey ^= Zobrist.pieces[zobristIndex(pieceType)][square];
+    psqt -= PSQT.psq[pieceType + 6][square];
+    phase -= PHASE_WEIGHT[typeOf(pieceType)];
+    pieces[colorOf(pieceType)][typeOf(pieceType)] &= mask;
+    pieceOn[square] = 0;
+    occupancy[colorOf(pieceType)] &= mask;
+    occupied &= mask;
+}
+
+// ---------- attackersTo ----------
+uint64_t Board::attackersTo(int square, uint64_t occupied) const
+{
+    // A pawn of colour c attacks `square` iff a pawn of the other colour on
+    // `square` would attack it, so the table is read with the colours swapped
+    uint64_t diagonal = pieces[WHITE][BISHOP] | pieces[BLACK][BISHOP] |
+                        pieces[WHITE][QUEEN] | pieces[BLACK][QUEEN];
+    uint64_t straight = pieces[WHITE][ROOK] | pieces[BLACK][ROOK] |
+                        pieces[WHITE][QUEEN] | pieces[BLACK][QUEEN];
+
+    return (pawnAttacks(BLACK, square) & pieces[WHITE][PAWN]) |
+           (pawnAttacks(WHITE, square) & pieces[BLACK][PAWN]) |
+           (knightAttacks(square) & (pieces[WHITE][KNIGHT] | pieces[BLACK][KNIGHT])) |
+           (kingAttacks(square) & (pieces[WHITE][KING] | pieces[BLACK][KING])) |
+           (bishopAttacks(square, occupied) & diagonal) |
+           (rookAttacks(square, occupied) & straight);
+}
+
+// ---------- isSquareAttacked ----------
+bool Board::isSquareAttacked(int square, Color byColor) const
+{
+    const uint64_t *them = pieces[byColor];
+
+    // Cheapest lookups first so most answers come before the slider probes
+    return (pawnAttacks(~byColor, square) & them[PAWN]) ||
+           (knightAttacks(square) & them[KNIGHT]) ||
+           (kingAttacks(square) & them[KING]) ||
+           (bishopAttacks(square, occupied) & (them[BISHOP] | them[QUEEN])) ||
+           (rookAttacks(square, occupied) & (them[ROOK] | them[QUEEN]));
+}
+
+// ---------- inCheck ----------
+bool Board::inCheck() const
+{
+    Color us = whiteToMove ? WHITE : BLACK;
+    return isSquareAttacked(findLSB(pieces[us][KING]), ~us);
+}
+
+// ---------- see ----------
+int Board::see(Move move) const
+{
+    if (move.isCastling())
+        return 0;
+
+    int from = move.from();
+    int to = move.to();
+    Color side = whiteToMove ? WHITE : BLACK;
+
+    // gain[d]: material balance for the side making capture d if the sequence stops there
+    int gain[32];
+    int depth = 0;
+    uint64_t occ = occupied ^ (1ULL << from);
+
+    if (move.isEnPassant())
+    {
+        occ ^= 1ULL << (to + (side == WHITE ? SOUTH : NORTH));
+        gain[0] = PIECE_VALUE[PAWN];
+    }
+    else
+        gain[0] = pieceOn[to] ? PIECE_VALUE[typeOf(pieceOn[to])] : 0;
+
+    // The piece now standing on `to`, next in line to be captured
+    int onSquare = PIECE_VALUE[typeOf(pieceOn[from])];
+    if (move.isPromotion())
+    {
+        gain[0] += PIECE_VALUE[move.promotionType()] - PIECE_VALUE[PAWN];
+        onSquare = PIECE_VALUE[move.promotionType()];
+    }
+
+    uint64_t diagonal = pieces[WHITE][BISHOP] | pieces[BLACK][BISHOP] | pieces[WHITE][QUEEN] | pieces[BLACK][QUEEN];
+    uint64_t straight = pieces[WHITE][ROOK] | pieces[BLACK][ROOK] | pieces[WHITE][QUEEN] | pieces[BLACK][QUEEN];
+    uint64_t attackers = attackersTo(to, occ) & occ;
+
+    while (true)
+    {
+        side = ~side;
+        uint64_t ours = attackers & occupancy[side];
+        if (!ours)
+            break;
+
+        // Least valuable attacker
+        PieceType pt = PAWN;
+        while (!(ours & pieces[side][pt]))
+            pt = PieceType(pt + 1);
+
+        // The king may only recapture if nothing defends the square any more
+        if (pt == KING && (attackers & occupancy[~side]))
+            break;
+
+        depth++;
+        gain[depth] = onSquare - gain[depth - 1];
+        onSquare = PIECE_VALUE[pt];
+
+        // Lift the capturer and let sliders behind it through
+        occ ^= 1ULL << findLSB(ours & pieces[side][pt]);
+        if (pt == PAWN || pt == BISHOP || pt == QUEEN)
+            attackers |= bishopAttacks(to, occ) & diagonal;
+        if (pt == ROOK || pt == QUEEN)
+            attackers |= rookAttacks(to, occ) & straight;
+        attackers &= occ;
+    }
+
+    // Each side stops capturing once continuing would do worse than standing pat
+    while (depth > 0)
+    {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+    return gain[0];
+}
+
+// ---------- isLegal ----------
+bool Board::isLegal(Move move) const
+{
+    Color us = whiteToMove ? WHITE : BLACK;
+    Color them = ~us;
+    int from = move.from();
+    int to = move.to();
+    int flags = move.flags();
+    int piece = pieceOn[from];
+    int victim = pieceOn[to];
+    uint64_t toBB = 1ULL << to;
+
+    // Flags 6 and 7 are unused by the encoding
+    if (from == to || !piece || colorOf(piece) != us || flags == 6 || flags == 7)
+        return false;
+    if (victim && (colorOf(victim) == us || typeOf(victim) == KING))
+        return false;
+
+    if (move.isCastling())
+    {
+        MoveList quiets;
+        generate<QUIETS>(*this, quiets);
+        return std::find(quiets.begin(), quiets.end(), move) != quiets.end();
+    }
+
+    PieceType pt = typeOf(piece);
+    int ksq = findLSB(pieces[us][KING]);
+    int up = us == WHITE ? NORTH : SOUTH;
+
+    if (move.isEnPassant())
+    {
+        if (pt != PAWN || toBB != enPassantTarget || !(pawnAttacks(us, from) & toBB))
+            return false;
+
+        // Replay the capture on the occupancy and look for any attack on our king
+        int capturedSquare = to - up;
+        uint64_t occ = (occupied ^ (1ULL << from) ^ (1ULL << capturedSquare)) | toBB;
+        return !(attackersTo(ksq, occ) & occupancy[them] & ~(1ULL << capturedSquare));
+    }
+
+    // ---- Pseudo-legality ----
+    if (move.isCapture() != (victim != 0))
+        return false;
+
+    if (pt == PAWN)
+    {
+        uint64_t lastRank = us == WHITE ? RANK_8_BB : RANK_1_BB;
+        if (move.isPromotion() != ((lastRank & toBB) != 0))
+            return false;
+
+        if (move.isCapture())
+        {
+            if (!(pawnAttacks(us, from) & toBB))
+                return false;
+        }
+        else if (flags == Move::DOUBLE_PUSH)
+        {
+            uint64_t startRank = us == WHITE ? RANK_2_BB : RANK_7_BB;
+            if (!(startRank & (1ULL << from)) || to != from + 2 * up || (occupied & ((1ULL << (from + up)) | toBB)))
+                return false;
+        }
+        else if (to != from + up)
+            return false;
+    }
+    else
+    {
+        if (move.isPromotion() || flags == Move::DOUBLE_PUSH)
+            return false;
+
+        uint64_t reach = pt == KNIGHT   ? knightAttacks(from)
+                         : pt == BISHOP ? bishopAttacks(from, occupied)
+                         : pt == ROOK   ? rookAttacks(from, occupied)
+                         : pt == QUEEN  ? queenAttacks(from, occupied)
+                                        : kingAttacks(from);
+        if (!(reach & toBB))
+            return false;
+    }
+
+    // ---- Legality ----
+    // The king may not step onto a square attacked once it has left `from`
+    if (pt == KING)
+        return !(attackersTo(to, occupied ^ (1ULL << from)) & occupancy[them] & ~toBB);
+
+    // Any other move must capture or block a single checker...
+    uint64_t checkers = attackersTo(ksq, occupied) & occupancy[them];
+    if (checkers)
+    {
+        if (checkers & (checkers - 1))
+            return false;
+        if (!((checkers | betweenBB(ksq, findLSB(checkers))) & toBB))
+            return false;
+    }
+
+    // ...and must not uncover a slider on the king
+    uint64_t occ = (occupied ^ (1ULL << from)) | toBB;
+    uint64_t sliders = ((bishopAttacks(ksq, occ) & (pieces[them][BISHOP] | pieces[them][QUEEN])) |
+                        (rookAttacks(ksq, occ) & (pieces[them][ROOK] | pieces[them][QUEEN])));
+    return !(sliders & ~toBB);
+}
+
+// ---------- isDraw ----------
+bool Board::isDraw() const
+{
+    if (halfmoveClock >= 100)
+        return true;
 
-    switch (pieceType)
+    // Only positions since the last capture, pawn move or null move can repeat,
+    // and only those with the same side to move (an even number of plies back)
+    int size = static_cast<int>(moveHistory.size());
+    for (int i = size - 1; i >= 0 && size - i <= halfmoveClock; i--)
     {
-    case 1:
-        whitePawns &= mask;
-        break;
-    case 2:
-        whiteKnights &= mask;
-        break;
-    case 3:
-        whiteBishops &= mask;
-        break;
-    case 4:
-        whiteRooks &= mask;
-        break;
-    case 5:
-        whiteQueen &= mask;
-        break;
-    case 6:
-        whiteKing &= mask;
-        break;
-    case -1:
-        blackPawns &= mask;
-        break;
-    case -2:
-        blackKnights &= mask;
-        break;
-    case -3:
-        blackBishops &= mask;
-        break;
-    case -4:
-        blackRooks &= mask;
-        break;
-    case -5:
-        blackQueen &= mask;
-        break;
-    case -6:
-        blackKing &= mask;
-        break;
-    default:
-        break;
+        if (moveHistory[i].move == Move::none())
+            break;
+        if ((size - i) % 2 == 0 && moveHistory[i].positionKey == positionKey)
+            return true;
     }
+    return false;
 }
 
 // ---------- printBitboard ----------
@@ -259,7 +379,7 @@ void Board::printBitboard(uint64_t bitboard)
 }
 
 // ---------- makeMove ----------
-void Board::makeMove(int fromSquare, int toSquare)
+void Board::makeMove(int fromSquare, int toSquare, PieceType promotion)
 {
     // 1. Check piece color vs. side to move
     int currPiece = findPiece(fromSquare);
@@ -273,868 +393,483 @@ void Board::makeMove(int fromSquare, int toSquare)
     }
 
     // 2. Generate legal moves and validate
-    std::vector<Move> legalMoves = generateMoves(*this);
-    bool moveFound = false;
-    Move selectedMove;
+    MoveList legalMoves;
+    generateMoves(*this, legalMoves);
 
-    for (const Move &move : legalMoves)
+    for (Move move : legalMoves)
     {
-        if (move.fromSquare == fromSquare && move.toSquare == toSquare)
+        if (move.from() == fromSquare && move.to() == toSquare &&
+            (!move.isPromotion() || move.promotionType() == promotion))
         {
-            moveFound = true;
-            selectedMove = move;
-            break;
+            doMove(move);
+            return;
         }
     }
 
-    if (!moveFound)
-    {
-        throw std::invalid_argument("Illegal move");
-    }
+    throw std::invalid_argument("Illegal move");
+}
 
-    // 3. Check capture
-    int capPiece = findPiece(toSquare);
+// ---------- doMove ----------
+void Board::doMove(Move move)
+{
+    if (whiteToMove)
+        doMove<WHITE>(move);
+    else
+        doMove<BLACK>(move);
+}
 
-    // 4. Save Move info
-    Move newMove = selectedMove; // Use the move we found from legal moves
-    newMove.capturedPiece = capPiece;
-    newMove.prevCastlingRights = castlingRights;
-    newMove.prevEntPassantTarget = enPassantTarget;
-    newMove.oldHalfmoveClock = halfmoveClock;
-    newMove.oldFullmoveCounter = fullmoveCounter;
+template <Color Us>
+void Board::doMove(Move move)
+{
+    constexpr int Down = (Us == WHITE) ? SOUTH : NORTH;
 
-    // 5. Capture
-    if (capPiece != 0)
-    {
-        removePiece(capPiece, toSquare);
+    int fromSquare = move.from();
+    int toSquare = move.to();
+    int currPiece = findPiece(fromSquare);
 
-        // Possibly remove castling rights if we captured a rook in its corner
-        if (abs(capPiece) == 4)
-        {
-            switch (toSquare)
-            {
-            case 0:
-                castlingRights &= ~0b0100;
-                break; // White Q-side
-            case 7:
-                castlingRights &= ~0b1000;
-                break; // White K-side
-            case 56:
-                castlingRights &= ~0b0001;
-                break; // Black q-side
-            case 63:
-                castlingRights &= ~0b0010;
-                break; // Black k-side
-            default:
-                break;
-            }
-        }
-    }
+    // 1. Check capture (the en passant victim sits behind the target square)
+    int capSquare = move.isEnPassant() ? toSquare + Down : toSquare;
+    int capPiece = findPiece(capSquare);
+
+    // 2. Save undo info
+    StateInfo state;
+    state.move = move;
+    state.capturedPiece = capPiece;
+    state.castlingRights = castlingRights;
+    state.enPassantTarget = enPassantTarget;
+    state.halfmoveClock = halfmoveClock;
+    state.fullmoveCounter = fullmoveCounter;
+    state.positionKey = positionKey;
+
+    // Castling and en passant keys are swapped out here and back in at the end
+    positionKey ^= Zobrist.castling[castlingRights];
+    if (enPassantTarget)
+        positionKey ^= Zobrist.enPassant[findLSB(enPassantTarget) % 8];
 
-    // 6. Move piece
-    movePiece(currPiece, fromSquare, toSquare);
+    // 3. Capture
+    if (capPiece != 0)
+        removePiece(capPiece, capSquare);
 
-    // 7. Handle castling
-    if (selectedMove.isCastling)
-    {
-        int rookType = (currPiece > 0) ? 4 : -4;
-        movePiece(rookType, selectedMove.rookFromSquare, selectedMove.rookToSquare);
-    }
+    // 4. Move piece
+    movePiece(currPiece, fromSquare, toSquare);
 
-    // 8. Handle en passant
-    if (abs(currPiece) == 1)
+    // 5. Handle castling (rook squares follow from the king's destination)
+    if (move.isCastling())
     {
-        if (abs(fromSquare - toSquare) == 16)
-        {
-            // Double pawn push => set en passant
-            int epSquareIdx = (fromSquare + toSquare) / 2;
-            enPassantTarget = (1ULL << epSquareIdx);
-        }
+        constexpr int Rook = makePiece(Us, ROOK);
+        if (move.flags() == Move::KING_CASTLE)
+            movePiece(Rook, fromSquare + 3, fromSquare + 1);
         else
-        {
-            enPassantTarget = 0ULL;
-        }
-    }
-    else
-    {
-        enPassantTarget = 0ULL;
+            movePiece(Rook, fromSquare - 4, fromSquare - 1);
     }
 
-    // 9. Handle promotion
-    if (selectedMove.promotedPiece != 0)
+    // 6. Double pawn push => set en passant target behind the pawn
+    enPassantTarget = (move.flags() == Move::DOUBLE_PUSH) ? (1ULL << (toSquare + Down)) : 0ULL;
+
+    // 7. Handle promotion
+    if (move.isPromotion())
     {
         removePiece(currPiece, toSquare);
-        placePiece(selectedMove.promotedPiece, toSquare);
+        placePiece(makePiece(Us, move.promotionType()), toSquare);
     }
 
-    // 10. Update castling rights
-    if (abs(currPiece) == 6) // King
-    {
-        if (currPiece > 0)
-            castlingRights &= 0b0011; // Remove white castling rights
-        else
-            castlingRights &= 0b1100; // Remove black castling rights
-    }
-    else if (abs(currPiece) == 4) // Rook
-    {
-        if (currPiece > 0)
-        {
-            if (fromSquare == 0)
-                castlingRights &= ~0b0100; // White Q
-            if (fromSquare == 7)
-                castlingRights &= ~0b1000; // White K
-        }
-        else
-        {
-            if (fromSquare == 56)
-                castlingRights &= ~0b0001; // Black q
-            if (fromSquare == 63)
-                castlingRights &= ~0b0010; // Black k
-        }
-    }
+    // 8. Update castling rights: a king or rook leaving, or a rook being captured
+    castlingRights &= CASTLING_RIGHTS_MASK[fromSquare] & CASTLING_RIGHTS_MASK[toSquare];
 
-    // 11. Update move counters
-    if (abs(currPiece) == 1 || capPiece != 0)
+    // 9. Update move counters
+    if (typeOf(currPiece) == PAWN || capPiece != 0)
         halfmoveClock = 0;
     else
         halfmoveClock++;
 
-    whiteToMove = !whiteToMove;
-    if (!whiteToMove)
-        fullmoveCounter++;
+    if (Us == BLACK)
+        fullmoveCounter++; // Black just completed the move pair
+    whiteToMove = (Us == BLACK);
+
+    // 10. Hash in the new castling rights, en passant file and side to move
+    positionKey ^= Zobrist.castling[castlingRights] ^ Zobrist.blackToMove;
+    if (enPassantTarget)
+        positionKey ^= Zobrist.enPassant[findLSB(enPassantTarget) % 8];
+
+    // Start loading the child's hash bucket while the caller generates its moves
+    TT.prefetch(positionKey);
 
     // Save the move
-    moveHistory.push(newMove);
+    moveHistory.push_back(state);
+
+#ifdef DEBUG_ZOBRIST
+    verifyPositionKey();
+#endif
 }
 
+template void Board::doMove<WHITE>(Move move);
+template void Board::doMove<BLACK>(Move move);
+
 // ---------- undoMove ----------
 void Board::undoMove()
 {
     if (moveHistory.empty())
         throw std::runtime_error("No moves to undo.");
 
-    Move lastMove = moveHistory.top();
-    moveHistory.pop();
+    const StateInfo state = moveHistory.back();
+    moveHistory.pop_back();
 
-    int fromSquare = lastMove.fromSquare;
-    int toSquare = lastMove.toSquare;
-    int movedPieceType = lastMove.movedPiece;
-    int capturedPieceType = lastMove.capturedPiece;
+    Move lastMove = state.move;
+    int fromSquare = lastMove.from();
+    int toSquare = lastMove.to();
 
     // Restore the board state
-    castlingRights = lastMove.prevCastlingRights;
+    castlingRights = state.castlingRights;
     whiteToMove = !whiteToMove; // revert
-    enPassantTarget = lastMove.prevEntPassantTarget;
-    halfmoveClock = lastMove.oldHalfmoveClock;
-    fullmoveCounter = lastMove.oldFullmoveCounter;
+    enPassantTarget = state.enPassantTarget;
+    halfmoveClock = state.halfmoveClock;
+    fullmoveCounter = state.fullmoveCounter;
 
     // Handle promotion revert
-    if (lastMove.promotedPiece != 0)
+    if (lastMove.isPromotion())
     {
-        removePiece(lastMove.promotedPiece, toSquare);
+        Color us = whiteToMove ? WHITE : BLACK;
+        removePiece(makePiece(us, lastMove.promotionType()), toSquare);
         // Put original pawn back
-        if (lastMove.promotedPiece > 0)
-            placePiece(1, toSquare); // White
-        else
-            placePiece(-1, toSquare); // Black
+        placePiece(makePiece(us, PAWN), toSquare);
     }
 
     // Move the piece back
+    int movedPieceType = findPiece(toSquare);
     movePiece(movedPieceType, toSquare, fromSquare);
 
     // If castling, move the rook back
-    if (lastMove.isCastling)
+    if (lastMove.isCastling())
     {
         int rookType = (movedPieceType > 0) ? 4 : -4;
-        movePiece(rookType, lastMove.rookToSquare, lastMove.rookFromSquare);
+        if (lastMove.flags() == Move::KING_CASTLE)
+            movePiece(rookType, fromSquare + 1, fromSquare + 3);
+        else
+            movePiece(rookType, fromSquare - 1, fromSquare - 4);
     }
 
     // If there was a captured piece, restore it
-    if (capturedPieceType != 0)
+    if (state.capturedPiece != 0)
     {
-        placePiece(capturedPieceType, toSquare);
+        int capSquare = toSquare;
+        if (lastMove.isEnPassant())
+            capSquare = whiteToMove ? toSquare + SOUTH : toSquare + NORTH;
+        placePiece(state.capturedPiece, capSquare);
     }
-}
-
-// ----------- MOVE GENERATION -------------
 
-// Precompute knight attack masks
-constexpr uint64_t knightAttacks(int square)
-{
-    uint64_t attacks = 0;
-    int x = square % 8, y = square / 8;
-    for (int dx : {-2, -1, 1, 2})
-    {
-        for (int dy : {-2, -1, 1, 2})
-        {
-            if (abs(dx) + abs(dy) == 3)
-            {
-                int nx = x + dx, ny = y + dy;
-                if (nx >= 0 && nx < 8 && ny >= 0 && ny < 8)
-                    attacks |= 1ULL << (ny * 8 + nx);
-            }
-        }
-    }
-    return attacks;
-}
+    // Piece updates above touched the key; the saved one is authoritative
+    positionKey = state.positionKey;
 
-// Precompute king attack masks
-constexpr uint64_t kingAttacks(int square)
-{
-    uint64_t attacks = 0;
-    int x = square % 8, y = square / 8;
-    for (int dx : {-1, 0, 1})
-    {
-        for (int dy : {-1, 0, 1})
-        {
-            if (dx == 0 && dy == 0)
-                continue;
-            int nx = x + dx, ny = y + dy;
-            if (nx >= 0 && nx < 8 && ny >= 0 && ny < 8)
-                attacks |= 1ULL << (ny * 8 + nx);
-        }
-    }
-    return attacks;
+#ifdef DEBUG_ZOBRIST
+    verifyPositionKey();
+#endif
 }
 
-// Ray attacks for sliding pieces (Bishop/Rook/Queen)
-uint64_t rayAttacks(int square, const std::vector<std::pair<int, int>> &directions, uint64_t occupied)
+// ---------- makeNullMove ----------
+void Board::makeNullMove()
 {
-    uint64_t attacks = 0;
-    int x = square % 8, y = square / 8;
-    for (auto [dx, dy] : directions)
-    {
-        for (int step = 1;; ++step)
-        {
-            int nx = x + dx * step, ny = y + dy * step;
-            if (nx < 0 || nx >= 8 || ny < 0 || ny >= 8)
-                break;
-            int target = ny * 8 + nx;
-            attacks |= 1ULL << target;
-            if (occupied & (1ULL << target))
-                break;
-        }
-    }
-    return attacks;
-}
+    StateInfo state;
+    state.move = Move::none();
+    state.capturedPiece = 0;
+    state.castlingRights = castlingRights;
+    state.enPassantTarget = enPassantTarget;
+    state.halfmoveClock = halfmoveClock;
+    state.fullmoveCounter = fullmoveCounter;
+    state.positionKey = positionKey;
+    moveHistory.push_back(state);
 
-// Bishop directions: 4 diagonals
-uint64_t bishopAttacks(int square, uint64_t occupied)
-{
-    return rayAttacks(square, bishopDirs, occupied);
-}
+    if (enPassantTarget)
+        positionKey ^= Zobrist.enPassant[findLSB(enPassantTarget) % 8];
+    enPassantTarget = 0;
 
-// Rook directions: 4 cardinals
-uint64_t rookAttacks(int square, uint64_t occupied)
-{
-    return rayAttacks(square, rookDirs, occupied);
-}
+    halfmoveClock++;
+    if (!whiteToMove)
+        fullmoveCounter++;
+    whiteToMove = !whiteToMove;
+    positionKey ^= Zobrist.blackToMove;
 
-uint64_t allPieces(const Board &board)
-{
-    return board.whitePawns | board.whiteKnights | board.whiteBishops |
-           board.whiteRooks | board.whiteQueen | board.whiteKing |
-           board.blackPawns | board.blackKnights | board.blackBishops |
-           board.blackRooks | board.blackQueen | board.blackKing;
-}
+    TT.prefetch(positionKey);
 
-uint64_t friendlyPieces(const Board &board)
-{
-    if (board.whiteToMove)
-        return board.whitePawns | board.whiteKnights | board.whiteBishops |
-               board.whiteRooks | board.whiteQueen | board.whiteKing;
-    else
-        return board.blackPawns | board.blackKnights | board.blackBishops |
-               board.blackRooks | board.blackQueen | board.blackKing;
+#ifdef DEBUG_ZOBRIST
+    verifyPositionKey();
+#endif
 }
 
-uint64_t enemyPieces(const Board &board)
+// ---------- undoNullMove ----------
+void Board::undoNullMove()
 {
-    if (board.whiteToMove)
-        return board.blackPawns | board.blackKnights | board.blackBishops |
-               board.blackRooks | board.blackQueen | board.blackKing;
-    else
-        return board.whitePawns | board.whiteKnights | board.whiteBishops |
-               board.whiteRooks | board.whiteQueen | board.whiteKing;
+    const StateInfo &state = moveHistory.back();
+    enPassantTarget = state.enPassantTarget;
+    halfmoveClock = state.halfmoveClock;
+    fullmoveCounter = state.fullmoveCounter;
+    positionKey = state.positionKey;
+    whiteToMove = !whiteToMove;
+    moveHistory.pop_back();
 }
 
-int findLSB(uint64_t bitboard)
+// ---------- verifyPositionKey ----------
+void Board::verifyPositionKey() const
 {
-    if (bitboard == 0)
-        return -1;
-#if defined(__GNUC__) || defined(__clang__)
-    return __builtin_ctzll(bitboard);
-#else
-    int idx = 0;
-    while (!(bitboard & 1ULL))
-    {
-        bitboard >>= 1;
-        ++idx;
-    }
-    return idx;
-#endif
+    if (positionKey != calculatePositionKey())
+        throw std::logic_error("Incremental Zobrist key diverged from full recomputation");
+    if (pawnKey != calculatePawnKey())
+        throw std::logic_error("Incremental pawn key diverged from full recomputation");
 }
 
-std::vector<Board::Move> generateMoves(Board &board)
+uint64_t Board::calculatePositionKey() const
 {
-    std::vector<Board::Move> moves;
-    uint64_t friendly = friendlyPieces(board);
-    uint64_t enemy = enemyPieces(board);
-    uint64_t all = allPieces(board);
+    uint64_t key = 0;
 
-    if (board.whiteToMove)
+    // Hash pieces
+    for (int square = 0; square < 64; square++)
     {
-        // White pawn moves
-        uint64_t pawns = board.whitePawns;
-        while (pawns)
-        {
-            int sq = findLSB(pawns);
-            pawns &= (pawns - 1);
-            int rank = sq / 8, file = sq % 8;
-            // Single push
-            int target = sq + 8;
-            if (target < 64 && !(all & (1ULL << target)))
-            {
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = 1;
-                moves.push_back(move);
-                // Double push from starting rank (rank 1 in 0-indexed)
-                if (rank == 1)
-                {
-                    int target2 = sq + 16;
-                    if (!(all & (1ULL << target2)))
-                    {
-                        Board::Move move2;
-                        move2.fromSquare = sq;
-                        move2.toSquare = target2;
-                        move2.movedPiece = 1;
-                        moves.push_back(move2);
-                    }
-                }
-            }
-            // Captures: diagonal left and right
-            if (file > 0)
-            {
-                int target = sq + 7;
-                if (target < 64 && (enemy & (1ULL << target)))
-                {
-                    Board::Move move;
-                    move.fromSquare = sq;
-                    move.toSquare = target;
-                    move.movedPiece = 1;
-                    moves.push_back(move);
-                }
-            }
-            if (file < 7)
-            {
-                int target = sq + 9;
-                if (target < 64 && (enemy & (1ULL << target)))
-                {
-                    Board::Move move;
-                    move.fromSquare = sq;
-                    move.toSquare = target;
-                    move.movedPiece = 1;
-                    moves.push_back(move);
-                }
-            }
-        }
-        // White knight moves
-        uint64_t knights = board.whiteKnights;
-        while (knights)
-        {
-            int sq = findLSB(knights);
-            knights &= (knights - 1);
-            uint64_t knightMoves = knightAttacks(sq);
-            knightMoves &= ~friendly;
-            while (knightMoves)
-            {
-                int target = findLSB(knightMoves);
-                knightMoves &= (knightMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = 2;
-                moves.push_back(move);
-            }
-        }
-        // White bishop moves
-        uint64_t bishops = board.whiteBishops;
-        while (bishops)
-        {
-            int sq = findLSB(bishops);
-            bishops &= (bishops - 1);
-            uint64_t bishopMoves = bishopAttacks(sq, all);
-            bishopMoves &= ~friendly;
-
-            while (bishopMoves)
-            {
-                int target = findLSB(bishopMoves);
-                bishopMoves &= (bishopMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = 3;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
-        }
-
-        // White rook moves
-        uint64_t rooks = board.whiteRooks;
-        while (rooks)
+        int piece = findPiece(square);
+        if (piece != 0)
         {
-            int sq = findLSB(rooks);
-            rooks &= (rooks - 1);
-            uint64_t rookMoves = rookAttacks(sq, all);
-            rookMoves &= ~friendly;
-
-            while (rookMoves)
-            {
-                int target = findLSB(rookMoves);
-                rookMoves &= (rookMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = 4;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
+            int pieceIndex = (piece > 0 ? piece - 1 : -piece + 5); // Map to 0-11
+            key ^= Zobrist.pieces[pieceIndex][square];
         }
+    }
 
-        // White queen moves
-        uint64_t queens = board.whiteQueen;
-        while (queens)
-        {
-            int sq = findLSB(queens);
-            queens &= (queens - 1);
-            uint64_t queenMoves = bishopAttacks(sq, all) | rookAttacks(sq, all);
-            queenMoves &= ~friendly;
+    // Hash side to move
+    if (!whiteToMove)
+    {
+        key ^= Zobrist.blackToMove;
+    }
 
-            while (queenMoves)
-            {
-                int target = findLSB(queenMoves);
-                queenMoves &= (queenMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = 5;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
-        }
+    // Hash castling rights
+    key ^= Zobrist.castling[castlingRights];
 
-        // White king moves
-        uint64_t king = board.whiteKing;
-        if (king)
-        {
-            int sq = findLSB(king);
-            uint64_t kingMoves = kingAttacks(sq);
-            kingMoves &= ~friendly;
+    // Hash en passant
+    if (enPassantTarget)
+    {
+        int epFile = findLSB(enPassantTarget) % 8;
+        key ^= Zobrist.enPassant[epFile];
+    }
 
-            while (kingMoves)
-            {
-                int target = findLSB(kingMoves);
-                kingMoves &= (kingMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = 6;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
+    return key;
+}
 
-            // Castling moves
-            if (board.castlingRights & 0b1000 &&        // King-side castle
-                !(all & ((1ULL << 5) | (1ULL << 6))) && // f1 and g1 must be empty
-                sq == 4)                                // King must be on e1
-            {
-                Board::Move move;
-                move.fromSquare = 4;
-                move.toSquare = 6;
-                move.movedPiece = 6;
-                move.isCastling = true;
-                move.rookFromSquare = 7;
-                move.rookToSquare = 5;
-                moves.push_back(move);
-            }
-            if (board.castlingRights & 0b0100 &&                      // Queen-side castle
-                !(all & ((1ULL << 1) | (1ULL << 2) | (1ULL << 3))) && // b1, c1, and d1 must be empty
-                sq == 4)                                              // King must be on e1
-            {
-                Board::Move move;
-                move.fromSquare = 4;
-                move.toSquare = 2;
-                move.movedPiece = 6;
-                move.isCastling = true;
-                move.rookFromSquare = 0;
-                move.rookToSquare = 3;
-                moves.push_back(move);
-            }
-        }
-    }
-    else
+uint64_t Board::calculatePawnKey() const
+{
+    uint64_t key = 0;
+    for (Color c : {WHITE, BLACK})
     {
-        // Black pawn moves
-        uint64_t pawns = board.blackPawns;
+        uint64_t pawns = pieces[c][PAWN];
         while (pawns)
         {
-            int sq = findLSB(pawns);
-            pawns &= (pawns - 1);
-            int rank = sq / 8, file = sq % 8;
-            // Single push (downward)
-            int target = sq - 8;
-            if (target >= 0 && !(all & (1ULL << target)))
-            {
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = -1;
-                moves.push_back(move);
-                // Double push from starting rank (rank 6 in 0-indexed)
-                if (rank == 6)
-                {
-                    int target2 = sq - 16;
-                    if (!(all & (1ULL << target2)))
-                    {
-                        Board::Move move2;
-                        move2.fromSquare = sq;
-                        move2.toSquare = target2;
-                        move2.movedPiece = -1;
-                        moves.push_back(move2);
-                    }
-                }
-            }
-            // Captures
-            if (file > 0)
-            {
-                int target = sq - 9;
-                if (target >= 0 && !(friendly & (1ULL << target)) && (enemy & (1ULL << target)))
-                {
-                    Board::Move move;
-                    move.fromSquare = sq;
-                    move.toSquare = target;
-                    move.movedPiece = -1;
-                    moves.push_back(move);
-                }
-            }
-            if (file < 7)
-            {
-                int target = sq - 7;
-                if (target >= 0 && (enemy & (1ULL << target)))
-                {
-                    Board::Move move;
-                    move.fromSquare = sq;
-                    move.toSquare = target;
-                    move.movedPiece = -1;
-                    moves.push_back(move);
-                }
-            }
-        }
-        // Black knight moves
-        uint64_t knights = board.blackKnights;
-        while (knights)
-        {
-            int sq = findLSB(knights);
-            knights &= (knights - 1);
-            uint64_t knightMoves = knightAttacks(sq);
-            knightMoves &= ~friendly;
-            while (knightMoves)
-            {
-                int target = findLSB(knightMoves);
-                knightMoves &= (knightMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = -2;
-                moves.push_back(move);
-            }
-        }
-        // Black bishop moves
-        uint64_t bishops = board.blackBishops;
-        while (bishops)
-        {
-            int sq = findLSB(bishops);
-            bishops &= (bishops - 1);
-            uint64_t bishopMoves = bishopAttacks(sq, all);
-            bishopMoves &= ~friendly;
-
-            while (bishopMoves)
-            {
-                int target = findLSB(bishopMoves);
-                bishopMoves &= (bishopMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = -3;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
-        }
-
-        // Black rook moves
-        uint64_t rooks = board.blackRooks;
-        while (rooks)
-        {
-            int sq = findLSB(rooks);
-            rooks &= (rooks - 1);
-            uint64_t rookMoves = rookAttacks(sq, all);
-            rookMoves &= ~friendly;
-
-            while (rookMoves)
-            {
-                int target = findLSB(rookMoves);
-                rookMoves &= (rookMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = -4;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
-        }
-
-        // Black queen moves
-        uint64_t queens = board.blackQueen;
-        while (queens)
-        {
-            int sq = findLSB(queens);
-            queens &= (queens - 1);
-            uint64_t queenMoves = bishopAttacks(sq, all) | rookAttacks(sq, all);
-            queenMoves &= ~friendly;
-
-            while (queenMoves)
-            {
-                int target = findLSB(queenMoves);
-                queenMoves &= (queenMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = -5;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
-        }
-
-        // Black king moves
-        uint64_t king = board.blackKing;
-        if (king)
-        {
-            int sq = findLSB(king);
-            uint64_t kingMoves = kingAttacks(sq);
-            kingMoves &= ~friendly;
-
-            while (kingMoves)
-            {
-                int target = findLSB(kingMoves);
-                kingMoves &= (kingMoves - 1);
-                Board::Move move;
-                move.fromSquare = sq;
-                move.toSquare = target;
-                move.movedPiece = -6;
-                move.capturedPiece = board.findPiece(target);
-                moves.push_back(move);
-            }
-
-            // Castling moves
-            if (board.castlingRights & 0b0010 &&          // King-side castle
-                !(all & ((1ULL << 61) | (1ULL << 62))) && // f8 and g8 must be empty
-                sq == 60)                                 // King must be on e8
-            {
-                Board::Move move;
-                move.fromSquare = 60;
-                move.toSquare = 62;
-                move.movedPiece = -6;
-                move.isCastling = true;
-                move.rookFromSquare = 63;
-                move.rookToSquare = 61;
-                moves.push_back(move);
-            }
-            if (board.castlingRights & 0b0001 &&                         // Queen-side castle
-                !(all & ((1ULL << 57) | (1ULL << 58) | (1ULL << 59))) && // b8, c8, and d8 must be empty
-                sq == 60)                                                // King must be on e8
-            {
-                Board::Move move;
-                move.fromSquare = 60;
-                move.toSquare = 58;
-                move.movedPiece = -6;
-                move.isCastling = true;
-                move.rookFromSquare = 56;
-                move.rookToSquare = 59;
-                moves.push_back(move);
-            }
+            key ^= Zobrist.pieces[zobristIndex(makePiece(c, PAWN))][findLSB(pawns)];
+            pawns &= pawns - 1;
         }
     }
-    return moves;
+    return key;
 }
 
-// perft: recursively counts leaf nodes up to a given depth
-uint64_t perft(Board &board, int depth)
+// Adds the attacks of side c's pieces of type Pt to the attack map
+template <PieceType Pt>
+static void addPieceAttacks(const Board &board, Color c, AttackMap &map)
 {
-    if (depth == 0)
-        return 1ULL;
-    uint64_t nodes = 0;
-    std::vector<Board::Move> moves = generateMoves(board);
-    for (auto &move : moves)
+    map.byType[c][Pt] = 0;
+    for (uint64_t bb = board.pieces[c][Pt]; bb; bb &= bb - 1)
     {
-        board.makeMove(move.fromSquare, move.toSquare);
-        nodes += perft(board, depth - 1);
-        board.undoMove();
+        int square = findLSB(bb);
+        uint64_t attacks = attacksFrom<Pt>(square, board.occupied);
+        map.bySquare[square] = attacks;
+        map.byType[c][Pt] |= attacks;
+        map.twice[c] |= map.byColor[c] & attacks;
+        map.byColor[c] |= attacks;
     }
-    return nodes;
 }
 
-// Initialize Zobrist hashing tables
-void Board::initZobrist()
+// ---------- buildAttackMap ----------
+void Board::buildAttackMap(AttackMap &map) const
 {
-    std::mt19937_64 rng(std::chrono::steady_clock::now().time_since_epoch().count());
-    for (int piece = 0; piece < 12; piece++)
-    {
-        for (int square = 0; square < 64; square++)
-        {
-            zobristTable[piece][square] = rng();
-        }
-    }
-    zobristBlackToMove = rng();
-    for (int i = 0; i < 16; i++)
-    {
-        zobristCastling[i] = rng();
-    }
-    for (int i = 0; i < 8; i++)
+    for (Color c : {WHITE, BLACK})
     {
-        zobristEnPassant[i] = rng();
+        uint64_t pawnAttacks = c == WHITE ? pawnAttacksBB<WHITE>(pieces[c][PAWN]) : pawnAttacksBB<BLACK>(pieces[c][PAWN]);
+        int ksq = findLSB(pieces[c][KING]);
+
+        map.byType[c][PAWN] = pawnAttacks;
+        map.byType[c][KING] = kingAttacks(ksq);
+        map.kingZone[c] = map.byType[c][KING] | (1ULL << ksq);
+        map.byColor[c] = pawnAttacks | map.byType[c][KING];
+        map.twice[c] = pawnAttacks & map.byType[c][KING];
+
+        addPieceAttacks<KNIGHT>(*this, c, map);
+        addPieceAttacks<BISHOP>(*this, c, map);
+        addPieceAttacks<ROOK>(*this, c, map);
+        addPieceAttacks<QUEEN>(*this, c, map);
     }
 }
 
-uint64_t Board::calculatePositionKey() const
-{
-    uint64_t key = 0;
+// Mobility per reachable square beyond MOBILITY_BASE, knight to queen: a
+// piece with the usual number of moves scores nothing
+constexpr Score MOBILITY[6] = {SCORE_ZERO, makeScore(4, 4), makeScore(5, 5), makeScore(2, 4), makeScore(1, 2), SCORE_ZERO};
+constexpr int MOBILITY_BASE[6] = {0, 4, 6, 7, 13, 0};
 
-    // Hash pieces
-    for (int square = 0; square < 64; square++)
-    {
-        int piece = findPiece(square);
-        if (piece != 0)
+// King danger: each knight, bishop, rook or queen attacking the king zone adds
+// its weight, scaled by the number of such attackers; a lone attacker is ignored
+constexpr int KING_ATTACK_WEIGHT[6] = {0, 2, 2, 3, 5, 0};
+constexpr int KING_ZONE_WEAK_SQUARE = 2;
+constexpr int KING_DANGER_CAP = 400;
+
+// ---------- mobility ----------
+Score Board::mobility(Color us, const AttackMap &map) const
+{
+    const uint64_t mobilityArea = ~occupancy[us] & ~map.byType[~us][PAWN];
+    Score score = SCORE_ZERO;
+    for (int pt = KNIGHT; pt <= QUEEN; pt++)
+        for (uint64_t bb = pieces[us][pt]; bb; bb &= bb - 1)
         {
-            int pieceIndex = (piece > 0 ? piece - 1 : -piece + 5); // Map to 0-11
-            key ^= zobristTable[pieceIndex][square];
+            int reach = __builtin_popcountll(map.bySquare[findLSB(bb)] & mobilityArea);
+            score += MOBILITY[pt] * (reach - MOBILITY_BASE[pt]);
         }
-    }
-
-    // Hash side to move
-    if (!whiteToMove)
-    {
-        key ^= zobristBlackToMove;
-    }
+    return score;
+}
 
-    // Hash castling rights
-    key ^= zobristCastling[castlingRights];
+// ---------- kingDanger ----------
+int Board::kingDanger(Color us, const AttackMap &map) const
+{
+    int attackers = 0;
+    int attackWeight = 0;
+    for (int pt = KNIGHT; pt <= QUEEN; pt++)
+        for (uint64_t bb = pieces[~us][pt]; bb; bb &= bb - 1)
+            if (map.bySquare[findLSB(bb)] & map.kingZone[us])
+            {
+                attackers++;
+                attackWeight += KING_ATTACK_WEIGHT[pt];
+            }
 
-    // Hash en passant
-    if (enPassantTarget)
-    {
-        int epFile = findLSB(enPassantTarget) % 8;
-        key ^= zobristEnPassant[epFile];
-    }
+    if (attackers < 2)
+        return 0;
 
-    return key;
+    // Zone squares the enemy attacks and nothing but our king defends
+    uint64_t kingOnly = map.byType[us][KING] & ~map.twice[us];
+    uint64_t weak = map.kingZone[us] & map.byColor[~us] & ~(map.byColor[us] & ~kingOnly);
+    return attackWeight * attackers + KING_ZONE_WEAK_SQUARE * __builtin_popcountll(weak);
 }
 
-int Board::evaluatePosition() const
+// Evaluation terms for one side, scored from that side's point of view
+template <Color C>
+static Score evaluateSide(const Board &board, const PawnEntry &pawns, const AttackMap &map)
 {
-    int score = 0;
-
-    // Material counting
-    score += __builtin_popcountll(whitePawns) * 100;
-    score += __builtin_popcountll(whiteKnights) * 320;
-    score += __builtin_popcountll(whiteBishops) * 330;
-    score += __builtin_popcountll(whiteRooks) * 500;
-    score += __builtin_popcountll(whiteQueen) * 900;
-
-    score -= __builtin_popcountll(blackPawns) * 100;
-    score -= __builtin_popcountll(blackKnights) * 320;
-    score -= __builtin_popcountll(blackBishops) * 330;
-    score -= __builtin_popcountll(blackRooks) * 500;
-    score -= __builtin_popcountll(blackQueen) * 900;
-
-    // Center control and piece development bonuses
+    const uint64_t *bb = board.pieces[C];
+    Score score = SCORE_ZERO;
+
+    // Center control and piece development matter only while pieces are being mobilized
     const uint64_t centerSquares = (1ULL << 27) | (1ULL << 28) | (1ULL << 35) | (1ULL << 36); // e4,d4,e5,d5
     const uint64_t extendedCenter = centerSquares |
                                     (1ULL << 26) | (1ULL << 29) | // c4,f4
                                     (1ULL << 34) | (1ULL << 37);  // c5,f5
 
     // Bonus for controlling center squares
-    uint64_t whitePieces = whitePawns | whiteKnights | whiteBishops | whiteRooks | whiteQueen | whiteKing;
-    uint64_t blackPieces = blackPawns | blackKnights | blackBishops | blackRooks | blackQueen | blackKing;
+    score += makeScore(10, 0) * __builtin_popcountll(board.occupancy[C] & centerSquares);
+    score += makeScore(5, 0) * __builtin_popcountll(board.occupancy[C] & extendedCenter);
 
-    score += 10 * __builtin_popcountll(whitePieces & centerSquares);
-    score += 5 * __builtin_popcountll(whitePieces & extendedCenter);
-    score -= 10 * __builtin_popcountll(blackPieces & centerSquares);
-    score -= 5 * __builtin_popcountll(blackPieces & extendedCenter);
+    // Bonus for developed minor pieces
+    const uint64_t backRank = (C == WHITE) ? 0xFFULL : 0xFF00000000000000ULL;
+    score += makeScore(20, 0) * __builtin_popcountll(bb[KNIGHT] & ~backRank);
+    score += makeScore(20, 0) * __builtin_popcountll(bb[BISHOP] & ~backRank);
 
-    // Development bonus for knights and bishops
-    const uint64_t whiteBackRank = 0xFFULL;
-    const uint64_t blackBackRank = 0xFF00000000000000ULL;
+    // Add bonus for bishop pair, worth more as the board opens up
+    if (__builtin_popcountll(bb[BISHOP]) >= 2)
+        score += makeScore(50, 70);
 
-    // Bonus for developed minor pieces
-    score += 20 * __builtin_popcountll(whiteKnights & ~whiteBackRank);
-    score += 20 * __builtin_popcountll(whiteBishops & ~whiteBackRank);
-    score -= 20 * __builtin_popcountll(blackKnights & ~blackBackRank);
-    score -= 20 * __builtin_popcountll(blackBishops & ~blackBackRank);
-
-    // Positional scoring for pawns
-    uint64_t wp = whitePawns;
-    while (wp)
-    {
-        int sq = findLSB(wp);
-        score += PAWN_TABLE[sq];
-        wp &= (wp - 1);
-    }
+    // A passed pawn with an enemy piece on its stop square is going nowhere.
+    // Depends on pieces, so it is applied here rather than cached with the pawns
+    uint64_t stopSquares = C == WHITE ? shift<NORTH>(pawns.passed[C]) : shift<SOUTH>(pawns.passed[C]);
+    score -= makeScore(5, 20) * __builtin_popcountll(stopSquares & board.occupancy[~C]);
 
-    uint64_t bp = blackPawns;
-    while (bp)
-    {
-        int sq = findLSB(bp);
-        score -= PAWN_TABLE[63 - sq]; // Flip table for black
-        bp &= (bp - 1);
-    }
+    // Mobility, and king safety while there is material to attack with
+    score += board.mobility(C, map);
+    score -= makeScore(std::min(board.kingDanger(C, map) * 4, KING_DANGER_CAP), 0);
 
-    // Positional scoring for knights
-    uint64_t wn = whiteKnights;
-    while (wn)
-    {
-        int sq = findLSB(wn);
-        score += KNIGHT_TABLE[sq];
-        wn &= (wn - 1);
-    }
+    return score;
+}
 
-    uint64_t bn = blackKnights;
-    while (bn)
+// Most squares a knight, bishop, rook or queen can reach, for bounding mobility
+constexpr int MOBILITY_MAX_REACH[6] = {0, 8, 13, 14, 27, 0};
+
+// Largest amounts by which the evaluateSide() terms can raise (gain) and
+// lower (loss) the score of side C, given the pieces actually on the board
+template <Color C>
+static void sideTermBounds(const Board &board, Score &gain, Score &loss)
+{
+    const uint64_t *bb = board.pieces[C];
+    int minors = __builtin_popcountll(bb[KNIGHT] | bb[BISHOP]);
+
+    // Center (4 x 10 + 8 x 5), development, bishop pair and blocked passers
+    gain = makeScore(80, 0) + makeScore(20, 0) * minors;
+    if (__builtin_popcountll(bb[BISHOP]) >= 2)
+        gain += makeScore(50, 70);
+    loss = makeScore(5, 20) * __builtin_popcountll(bb[PAWN]);
+
+    // Mobility swings between zero and full reach around the base per piece
+    for (int pt = KNIGHT; pt <= QUEEN; pt++)
     {
-        int sq = findLSB(bn);
-        score -= KNIGHT_TABLE[63 - sq];
-        bn &= (bn - 1);
+        int count = __builtin_popcountll(bb[pt]);
+        gain += MOBILITY[pt] * ((MOBILITY_MAX_REACH[pt] - MOBILITY_BASE[pt]) * count);
+        loss += MOBILITY[pt] * (MOBILITY_BASE[pt] * count);
     }
 
-    // Add bonus for bishop pair
-    if (__builtin_popcountll(whiteBishops) >= 2)
-        score += 50;
-    if (__builtin_popcountll(blackBishops) >= 2)
-        score -= 50;
+    // King danger needs at least two enemy pieces in the king zone
+    const uint64_t *enemy = board.pieces[~C];
+    if (__builtin_popcountll(enemy[KNIGHT] | enemy[BISHOP] | enemy[ROOK] | enemy[QUEEN]) >= 2)
+        loss += makeScore(KING_DANGER_CAP, 0);
+}
 
-    // Penalize doubled pawns
-    for (int file = 0; file < 8; file++)
+// Largest amount, per phase, by which the evaluateSide() terms can move the
+// score either way. Derived from the piece counts, so promotions widen it and
+// trades narrow it; one extra centipawn covers rounding in taper()
+static Score lazyMargin(const Board &board)
+{
+    Score whiteGain, whiteLoss, blackGain, blackLoss;
+    sideTermBounds<WHITE>(board, whiteGain, whiteLoss);
+    sideTermBounds<BLACK>(board, blackGain, blackLoss);
+    Score up = whiteGain + blackLoss;
+    Score down = whiteLoss + blackGain;
+    return makeScore(std::max(mgValue(up), mgValue(down)) + 1, std::max(egValue(up), egValue(down)) + 1);
+}
+
+// Interpolates a midgame/endgame pair by phase
+static int taper(Score score, int phase)
+{
+    // Promotions can push the phase past the starting material
+    int mgPhase = std::min(phase, PHASE_MIDGAME);
+    return (mgValue(score) * mgPhase + egValue(score) * (PHASE_MIDGAME - mgPhase)) / PHASE_MIDGAME;
+}
+
+int Board::evaluate(int alpha, int beta, PawnTable *pawnTable, EvalStats *stats) const
+{
+    PawnEntry computed;
+    const PawnEntry *pawns = pawnTable ? &pawnTable->probe(*this) : &computed;
+    if (!pawnTable)
+        evaluatePawns(*this, computed);
+
+    int sign = whiteToMove ? 1 : -1;
+    Score score = psqt + pawns->score;
+    int cheap = sign * taper(score, phase);
+    int margin = taper(lazyMargin(*this), phase);
+
+    if (stats)
+        stats->calls++;
+
+    if (cheap - margin >= beta || cheap + margin <= alpha)
     {
-        uint64_t fileMask = 0x0101010101010101ULL << file;
-        int whitePawnsOnFile = __builtin_popcountll(whitePawns & fileMask);
-        int blackPawnsOnFile = __builtin_popcountll(blackPawns & fileMask);
-        if (whitePawnsOnFile > 1)
-            score -= 20 * (whitePawnsOnFile - 1);
-        if (blackPawnsOnFile > 1)
-            score += 20 * (blackPawnsOnFile - 1);
+        if (stats)
+            stats->lazyExits++;
+        return cheap >= beta ? cheap - margin : cheap + margin;
     }
 
-    // Always return score from White's perspective
-    return score;
-}
\ No newline at end of file
+    AttackMap attacks;
+    buildAttackMap(attacks);
+    score += evaluateSide<WHITE>(*this, *pawns, attacks) - evaluateSide<BLACK>(*this, *pawns, attacks);
+    return sign * taper(score, phase);
+}
+
+int Board::evaluatePosition(PawnTable *pawnTable) const
+{
+    // Always return score from White's perspective; an unbounded window never exits early
+    int score = evaluate(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), pawnTable);
+    return whiteToMove ? score : -score;
+}
@@ -3,37 +3,77 @@
 
 #include <cstdint>
 #include <string>
-#include <stack>
 #include <vector>
 #include <initializer_list>
+#include "move.h"
+#include "types.h"
+
+class PawnTable;
+
+/**
+ * What each side attacks, built once per full evaluation by
+ * Board::buildAttackMap() so that mobility, king safety and any later term
+ * share the same bitboards instead of each walking the slider rays again.
+ */
+struct AttackMap
+{
+    // Attacks of the knight, bishop, rook or queen on each square; entries
+    // for other squares are left unset
+    uint64_t bySquare[64];
+
+    // Union of the attacks of each colour's pieces of one type
+    uint64_t byType[2][6];
+
+    // Every square a colour attacks, and those it attacks more than once
+    uint64_t byColor[2];
+    uint64_t twice[2];
+
+    // Each king's square and its neighbours
+    uint64_t kingZone[2];
+};
+
+// How often Board::evaluate() settled for its cheap terms
+struct EvalStats
+{
+    uint64_t calls = 0;
+    uint64_t lazyExits = 0;
+};
+
+/**
+ * Everything makeMove() overwrites that cannot be recomputed from the move
+ * itself. One record is pushed per move and popped by undoMove().
+ */
+struct StateInfo
+{
+    Move move;
+    int capturedPiece;
+    uint8_t castlingRights;
+    uint64_t enPassantTarget;
+    int halfmoveClock;
+    int fullmoveCounter;
+    uint64_t positionKey;
+};
 
 /**
  * Represents a chess board using bitboards.
  */
 class Board
 {
-private:
-    static void initZobrist();
-
 public:
     Board();
 
     // ----------------------------------
     // Core Data
     // ----------------------------------
-    uint64_t whitePawns;
-    uint64_t whiteKnights;
-    uint64_t whiteBishops;
-    uint64_t whiteRooks;
-    uint64_t whiteQueen;
-    uint64_t whiteKing;
-
-    uint64_t blackPawns;
-    uint64_t blackKnights;
-    uint64_t blackBishops;
-    uint64_t blackRooks;
-    uint64_t blackQueen;
-    uint64_t blackKing;
+    // Piece bitboards indexed by [Color][PieceType]
+    uint64_t pieces[2][6];
+
+    // Mailbox: signed piece code on each square (same encoding as findPiece)
+    int8_t pieceOn[64];
+
+    // Cached occupancy per Color, plus both sides
+    uint64_t occupancy[2];
+    uint64_t occupied;
 
     // Castling rights (4 bits: White King-side, White Queen-side, Black King-side, Black Queen-side)
     uint8_t castlingRights;
@@ -50,41 +90,61 @@ public:
     // Current player to move (true for White, false for Black)
     bool whiteToMove;
 
-    // ----------------------------------
-    // Move Structure
-    // ----------------------------------
-    struct Move
-    {
-        int fromSquare;
-        int toSquare;
-        int movedPiece;
-        int capturedPiece;
-        int promotedPiece;
-
-        unsigned char prevCastlingRights;
-        uint64_t prevEntPassantTarget;
-        int oldHalfmoveClock;
-        int oldFullmoveCounter;
+    // Zobrist key of the current position, updated incrementally by
+    // placePiece/removePiece and doMove, restored by undoMove
+    uint64_t positionKey;
 
-        bool isCastling;
-        int rookFromSquare;
-        int rookToSquare;
+    // Zobrist key of the pawns alone (same piece keys), maintained by
+    // placePiece/removePiece; indexes the pawn-structure cache
+    uint64_t pawnKey;
 
-        Move();
-    };
+    // Material plus piece-square score of every piece on the board, White
+    // minus Black, and the game phase (sum of PHASE_WEIGHT over all pieces).
+    // Kept in sync by placePiece/removePiece, so undoMove restores them with
+    // the pieces
+    Score psqt;
+    int phase;
 
-    // Stack to keep track of move history (for undo)
-    std::stack<Move> moveHistory;
+    // Undo records, one per move played (most recent at the back)
+    std::vector<StateInfo> moveHistory;
 
     // ----------------------------------
     // Board operations
     // ----------------------------------
     void resetBitboards();
-    void makeMove(int fromSquare, int toSquare);
+
+    /**
+     * Validated move entry point for user/GUI input: checks that the piece
+     * belongs to the side to move and that the move is legal, then plays it.
+     * Pawn moves to the last rank promote to `promotion`.
+     * Throws std::invalid_argument otherwise.
+     */
+    void makeMove(int fromSquare, int toSquare, PieceType promotion = QUEEN);
+
+    /**
+     * Plays a move produced by generateMoves() for this exact position without
+     * any validation. This is the hot path for perft and search.
+     */
+    void doMove(Move move);
+
+    // doMove() for a known side to move, with its constants resolved at compile time
+    template <Color Us>
+    void doMove(Move move);
+
+    // Reverts the last doMove()/makeMove().
     void undoMove();
 
     /**
-     * Finds which piece (type) is on a given square.
+     * Passes the turn without moving (for null-move pruning): clears the en
+     * passant square and flips the side to move. The undo record holds
+     * Move::none(), which also stops repetition detection from looking past
+     * it. Must be reverted with undoNullMove(), never undoMove().
+     */
+    void makeNullMove();
+    void undoNullMove();
+
+    /**
+     * Finds which piece (type) is on a given square (a single mailbox load).
      * Positive = White piece, Negative = Black piece, 0 if empty.
      */
     int findPiece(int square) const;
@@ -97,6 +157,8 @@ public:
 
     /**
      * Places a piece on a given square (no removal).
+     * Keeps the mailbox, occupancy, Zobrist key, piece-square score and phase
+     * in sync with the bitboards.
      */
     void placePiece(int pieceType, int square);
 
@@ -105,23 +167,91 @@ public:
      */
     void removePiece(int pieceType, int square);
 
+    // ----------------------------------
+    // Attack queries
+    // ----------------------------------
+
+    /**
+     * All pieces of either colour attacking `square`, with sliders blocked by
+     * `occupied` (pass a modified occupancy for x-ray or exchange analysis).
+     */
+    uint64_t attackersTo(int square, uint64_t occupied) const;
+
+    // True if any piece of colour `byColor` attacks `square` in the current position.
+    bool isSquareAttacked(int square, Color byColor) const;
+
+    // True if the side to move is in check.
+    bool inCheck() const;
+
+    /**
+     * Static exchange evaluation: the material the side to move wins (or, if
+     * negative, loses) on move.to() when both sides keep recapturing with
+     * their least valuable attacker and may stop whenever that is better.
+     * X-ray attackers behind each capturer join in; pins are ignored.
+     */
+    int see(Move move) const;
+
+    /**
+     * True if `move` is legal in this position. Accepts any 16-bit move, so a
+     * stale hash, killer or counter move can be checked without generating
+     * the move list; castling, being rare, is checked against the generator.
+     */
+    bool isLegal(Move move) const;
+
+    /**
+     * Fifty-move rule, or the current position already occurred since the last
+     * irreversible move or null move. A single repetition counts, as is usual
+     * inside a search.
+     */
+    bool isDraw() const;
+
     // Debug: prints an 8x8 grid for a given bitboard.
     void printBitboard(uint64_t bitboard);
 
-    // Zobrist hashing tables
-    static uint64_t zobristTable[12][64];
-    static uint64_t zobristBlackToMove;
-    static uint64_t zobristCastling[16];
-    static uint64_t zobristEnPassant[8];
-
     // ----------------------------------
     // Position evaluation and hashing
     // ----------------------------------
+    // Full recomputation from scratch; positionKey holds the incremental value
     uint64_t calculatePositionKey() const;
-    int evaluatePosition() const;
-};
+    uint64_t calculatePawnKey() const;
 
-std::vector<Board::Move> generateMoves(Board &board);
-uint64_t perft(Board &board, int depth);
+    /**
+     * Throws std::logic_error if positionKey or pawnKey differs from its full
+     * recomputation.
+     * Called after every doMove/undoMove when built with DEBUG_ZOBRIST.
+     */
+    void verifyPositionKey() const;
+
+    /**
+     * Static evaluation in centipawns from White's point of view. Every term
+     * is a midgame/endgame Score pair; the total is interpolated once, by
+     * phase, between its midgame and endgame values. Pawn structure is read
+     * from `pawnTable` when given, and computed afresh otherwise.
+     */
+    int evaluatePosition(PawnTable *pawnTable = nullptr) const;
+
+    /**
+     * Lazy evaluation from the side to move's point of view. Material, piece-
+     * square and pawn-structure terms come first; if they put the score more
+     * than the largest possible contribution of the remaining terms outside
+     * [alpha, beta], the nearest bound of the true score is returned instead
+     * (still outside the window) and the rest is skipped. Inside the window
+     * the result equals the full evaluation. Early exits are counted in
+     * `stats` when given.
+     */
+    int evaluate(int alpha, int beta, PawnTable *pawnTable = nullptr, EvalStats *stats = nullptr) const;
+
+    // Fills `map` from the current position
+    void buildAttackMap(AttackMap &map) const;
+
+    // Mobility of side `us`'s knights, bishops, rooks and queens over the
+    // squares holding no own piece and guarded by no enemy pawn
+    Score mobility(Color us, const AttackMap &map) const;
+
+    // King danger of side `us`, before scaling into the evaluation: enemy
+    // pieces bearing on the king zone and zone squares only the king defends.
+    // Zero below two attackers
+    int kingDanger(Color us, const AttackMap &map) const;
+};
 
 #endif // BOARD_H
@@ -45,6 +45,26 @@ namespace
 
         return std::string() + file + rank;
     }
+
+    // Signed piece codes (see Board::findPiece) indexed from -6 to +6
+    const char PIECE_CHARS[] = "kqrbnp.PNBRQK";
+
+    // FEN character for a signed piece code, or '\0' for an empty square
+    char pieceToChar(int piece)
+    {
+        return piece == 0 ? '\0' : PIECE_CHARS[piece + 6];
+    }
+
+    // Signed piece code for a FEN character, or 0 if it is not a piece letter
+    int charToPiece(char c)
+    {
+        for (int piece = -6; piece <= 6; piece++)
+        {
+            if (piece != 0 && PIECE_CHARS[piece + 6] == c)
+                return piece;
+        }
+        return 0;
+    }
 } // anonymous namespace
 
 std::string generateFEN(const Board &board)
@@ -57,36 +77,7 @@ std::string generateFEN(const Board &board)
     {
         for (int file = 0; file < 8; ++file)
         {
-            char piece = '\0';
-            int square = rank * 8 + file;
-            uint64_t mask = (1ULL << square);
-
-            // White
-            if (board.whitePawns & mask)
-                piece = 'P';
-            else if (board.whiteKnights & mask)
-                piece = 'N';
-            else if (board.whiteBishops & mask)
-                piece = 'B';
-            else if (board.whiteRooks & mask)
-                piece = 'R';
-            else if (board.whiteQueen & mask)
-                piece = 'Q';
-            else if (board.whiteKing & mask)
-                piece = 'K';
-            // Black
-            else if (board.blackPawns & mask)
-                piece = 'p';
-            else if (board.blackKnights & mask)
-                piece = 'n';
-            else if (board.blackBishops & mask)
-                piece = 'b';
-            else if (board.blackRooks & mask)
-                piece = 'r';
-            else if (board.blackQueen & mask)
-                piece = 'q';
-            else if (board.blackKing & mask)
-                piece = 'k';
+            char piece = pieceToChar(board.findPiece(rank * 8 + file));
 
             if (piece != '\0')
             {
@@ -173,7 +164,8 @@ void setBoardFromFEN(Board &board, const std::string &fenNotationStr)
         {
             if (c == '/')
             {
-                squareIndex -= 8;
+                // End of a rank: back to the a-file one rank down
+                squareIndex -= 16;
             }
             else if (std::isdigit(c))
             {
@@ -181,48 +173,10 @@ void setBoardFromFEN(Board &board, const std::string &fenNotationStr)
             }
             else
             {
-                uint64_t mask = (1ULL << squareIndex);
-                switch (c)
-                {
-                case 'P':
-                    board.whitePawns |= mask;
-                    break;
-                case 'N':
-                    board.whiteKnights |= mask;
-                    break;
-                case 'B':
-                    board.whiteBishops |= mask;
-                    break;
-                case 'R':
-                    board.whiteRooks |= mask;
-                    break;
-                case 'Q':
-                    board.whiteQueen |= mask;
-                    break;
-                case 'K':
-                    board.whiteKing |= mask;
-                    break;
-                case 'p':
-                    board.blackPawns |= mask;
-                    break;
-                case 'n':
-                    board.blackKnights |= mask;
-                    break;
-                case 'b':
-                    board.blackBishops |= mask;
-                    break;
-                case 'r':
-                    board.blackRooks |= mask;
-                    break;
-                case 'q':
-                    board.blackQueen |= mask;
-                    break;
-                case 'k':
-                    board.blackKing |= mask;
-                    break;
-                default:
+                int piece = charToPiece(c);
+                if (piece == 0)
                     throw std::invalid_argument("Invalid piece char in FEN.");
-                }
+                board.placePiece(piece, squareIndex);
                 squareIndex++;
             }
         }
@@ -268,4 +222,7 @@ void setBoardFromFEN(Board &board, const std::string &fenNotationStr)
 
     // 6. Fullmove
     board.fullmoveCounter = std::stoi(parts[5]);
+
+    // Side, castling and en passant were assigned directly, so rebuild the key
+    board.positionKey = board.calculatePositionKey();
 }
@@ -2,10 +2,24 @@
 #include <iostream>
 #include <fstream>
 #include <exception>
+#include <algorithm>
 #include <iomanip>
 #include <unordered_set>
+#include <set>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
 #include "board.h"
 #include "fen.h"
+#include "attacks.h"
+#include "movegen.h"
+#include "movepick.h"
+#include "pawns.h"
+#include "perft.h"
+#include "psqt.h"
+#include "search.h"
+#include "tt.h"
 
 void saveFENToFile(const std::string &fen, const std::string &filePath)
 {
@@ -28,6 +42,46 @@ void printTestHeader(const std::string &testName)
     std::cout << "----------------------------------------\n";
 }
 
+/**
+ * Plays `games` random games of at most `plies` moves from the board's
+ * position and calls visit(board) on every position reached, the start of
+ * each game included; with revisitOnUndo, also on every position restored by
+ * undoMove(). The board ends where it started. Returns the number of visits.
+ */
+template <typename Visit>
+int forEachPlayoutPosition(Board &board, unsigned seed, int games, int plies, Visit visit, bool revisitOnUndo = false)
+{
+    std::mt19937 rng(seed);
+    int visits = 0;
+    for (int game = 0; game < games; game++)
+    {
+        visit(board);
+        visits++;
+
+        int played = 0;
+        for (; played < plies; played++)
+        {
+            MoveList moves;
+            generateMoves(board, moves);
+            if (moves.empty())
+                break;
+            board.doMove(moves[static_cast<int>(rng() % moves.size())]);
+            visit(board);
+            visits++;
+        }
+        while (played-- > 0)
+        {
+            board.undoMove();
+            if (revisitOnUndo)
+            {
+                visit(board);
+                visits++;
+            }
+        }
+    }
+    return visits;
+}
+
 void testZobristConsistency(Board &board)
 {
     printTestHeader("Zobrist Hash Consistency");
@@ -53,6 +107,28 @@ void testZobristConsistency(Board &board)
     {
         std::cout << "❌ Zobrist hash consistency test failed\n";
     }
+
+    // Keys are compile-time constants, so independently built boards agree
+    Board fresh;
+    Board fromFEN;
+    setBoardFromFEN(fromFEN, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    if (fresh.positionKey == initialHash && fromFEN.positionKey == initialHash)
+        std::cout << "✅ Keys identical across Board instances\n";
+    else
+        std::cout << "❌ Keys differ between Board instances\n";
+
+    // Random playouts: the incremental key must match a full recomputation at every ply
+    int mismatches = 0;
+    auto checkKey = [&](const Board &b)
+    {
+        mismatches += b.positionKey != b.calculatePositionKey();
+    };
+    forEachPlayoutPosition(board, 2024, 100, 60, checkKey, true);
+
+    if (mismatches == 0)
+        std::cout << "✅ Incremental key matches full recomputation over random playouts\n";
+    else
+        std::cout << "❌ Incremental key diverged " << mismatches << " times\n";
 }
 
 void testPositionEvaluation(Board &board)
@@ -82,6 +158,63 @@ void testPositionEvaluation(Board &board)
     board.undoMove();
     board.undoMove();
     board.undoMove();
+
+    // The incremental piece-square score and phase must match a sum over the
+    // mailbox, after every move and every undo
+    auto fromScratch = [](const Board &b)
+    {
+        Score sum = SCORE_ZERO;
+        int phase = 0;
+        for (int square = 0; square < 64; square++)
+            if (b.pieceOn[square])
+            {
+                sum += PSQT.psq[b.pieceOn[square] + 6][square];
+                phase += PHASE_WEIGHT[typeOf(b.pieceOn[square])];
+            }
+        return b.psqt == sum && b.phase == phase;
+    };
+
+    Board playout;
+    setBoardFromFEN(playout, "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    int mismatches = 0;
+    auto checkIncremental = [&](const Board &b)
+    {
+        mismatches += !fromScratch(b);
+    };
+    forEachPlayoutPosition(playout, 5, 50, 60, checkIncremental, true);
+    if (mismatches == 0)
+        std::cout << "✅ Incremental piece-square score and phase match full recomputation\n";
+    else
+        std::cout << "❌ Incremental piece-square score or phase diverged " << mismatches << " times\n";
+
+    // Packed scores keep both halves through sums and differences of mixed signs
+    Score packed = makeScore(-35, 120) + makeScore(20, -300) - makeScore(-7, -1);
+    if (mgValue(packed) == -8 && egValue(packed) == -179 && mgValue(-packed) == 8 && egValue(-packed) == 179)
+        std::cout << "✅ Midgame/endgame score packing\n";
+    else
+        std::cout << "❌ Score packing lost a half: " << mgValue(packed) << ", " << egValue(packed) << "\n";
+
+    // With only kings and pawns left the endgame tables apply in full: a
+    // central king beats a cornered one, the reverse of the midgame preference
+    Board central, cornered;
+    setBoardFromFEN(central, "7k/8/8/8/4K3/8/4P3/8 w - - 0 1");
+    setBoardFromFEN(cornered, "7k/8/8/8/8/8/4P3/K7 w - - 0 1");
+    int kingDifference = central.evaluatePosition() - cornered.evaluatePosition();
+    if (central.phase == 0 && kingDifference > 0 && kingDifference == egValue(central.psqt) - egValue(cornered.psqt))
+        std::cout << "✅ Pawn ending uses endgame values (" << central.evaluatePosition() << " vs "
+                  << cornered.evaluatePosition() << ")\n";
+    else
+        std::cout << "❌ Pawn ending not tapered to endgame values\n";
+
+    // Colour-flipped positions score as exact opposites
+    Board white, black;
+    setBoardFromFEN(white, "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQK2R w KQkq - 0 1");
+    setBoardFromFEN(black, "rnbqk2r/ppp2ppp/3p1n2/2b1p3/2B1P3/2N2N2/PPPP1PPP/R1BQK2R b KQkq - 0 1");
+    if (initialScore == 0 && white.evaluatePosition() == -black.evaluatePosition())
+        std::cout << "✅ Evaluation is colour-symmetric\n";
+    else
+        std::cout << "❌ Evaluation is not colour-symmetric (" << white.evaluatePosition() << " vs "
+                  << black.evaluatePosition() << ")\n";
 }
 
 void testMoveGeneration(Board &board)
@@ -91,8 +224,13 @@ void testMoveGeneration(Board &board)
     // Test initial position move counts at various depths
     for (int depth = 1; depth <= 5; depth++)
     {
+        auto start = std::chrono::steady_clock::now();
         uint64_t nodes = perft(board, depth);
-        std::cout << "Perft(" << depth << ") = " << nodes << " nodes\n";
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        std::cout << "Perft(" << depth << ") = " << nodes << " nodes in "
+                  << std::fixed << std::setprecision(1) << ms << " ms\n";
+        std::cout.unsetf(std::ios::fixed);
 
         // Known correct values for initial position
         uint64_t expected[] = {20, 400, 8902, 197281, 4865609};
@@ -107,6 +245,869 @@ void testMoveGeneration(Board &board)
     }
 }
 
+void testPawnStructure()
+{
+    printTestHeader("Pawn Structure");
+
+    struct PawnCase
+    {
+        const char *name;
+        const char *fen;
+        int mg, eg;             // expected pawn score, White minus Black
+        uint64_t whitePassed;
+    };
+
+    const PawnCase cases[] = {
+        {"Isolated passer", "4k3/8/8/3P4/8/8/8/4K3 w - - 0 1", 25 - 10, 40 - 15, 1ULL << 35},
+        {"Doubled, rear not passed", "4k3/8/8/3P4/3P4/8/8/4K3 w - - 0 1", 25 - 15 - 2 * 10, 40 - 30 - 2 * 15, 1ULL << 35},
+        {"Backward d3", "4k3/8/8/4p3/2P1P3/3P4/8/4K3 w - - 0 1", 15 - 8 + 10, 25 - 12 + 15, 1ULL << 26},
+    };
+
+    for (const PawnCase &test : cases)
+    {
+        Board board;
+        setBoardFromFEN(board, test.fen);
+        PawnEntry entry;
+        evaluatePawns(board, entry);
+        if (mgValue(entry.score) == test.mg && egValue(entry.score) == test.eg && entry.passed[WHITE] == test.whitePassed)
+            std::cout << "✅ " << test.name << "\n";
+        else
+            std::cout << "❌ " << test.name << ": " << mgValue(entry.score) << ", " << egValue(entry.score) << "\n";
+    }
+
+    // Along random playouts the pawn key stays exact and a cached evaluation
+    // equals a fresh one
+    PawnTable table(1024);
+    Board board;
+    setBoardFromFEN(board, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    int mismatches = 0;
+    auto checkPawns = [&](const Board &b)
+    {
+        mismatches += b.pawnKey != b.calculatePawnKey() || b.evaluatePosition(&table) != b.evaluatePosition();
+    };
+    int positions = forEachPlayoutPosition(board, 23, 50, 60, checkPawns);
+
+    if (mismatches == 0)
+        std::cout << "✅ Pawn key and cached evaluation exact over " << positions << " positions\n";
+    else
+        std::cout << "❌ Pawn key or cached evaluation wrong in " << mismatches << " positions\n";
+}
+
+void testLazyEvaluation()
+{
+    printTestHeader("Lazy Evaluation");
+
+    // Over random playouts and windows: inside the window the lazy result is
+    // exact, and an early exit is a true bound on the full score that still
+    // falls outside the window
+    Board board;
+    setBoardFromFEN(board, "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    PawnTable table(1024);
+    EvalStats stats;
+    std::mt19937 rng(31);
+    int violations = 0;
+    auto checkLazy = [&](const Board &b)
+    {
+        int full = b.whiteToMove ? b.evaluatePosition() : -b.evaluatePosition();
+        int alpha = full + static_cast<int>(rng() % 4000) - 2000;
+        int beta = alpha + 1 + static_cast<int>(rng() % 100);
+        int lazy = b.evaluate(alpha, beta, &table, &stats);
+
+        bool sound = lazy > alpha && lazy < beta ? lazy == full
+                     : lazy >= beta             ? full >= lazy
+                                                : full <= lazy;
+        violations += !sound;
+
+        // A window around the true score can never be exited early: only an
+        // understated margin would make the cheap terms claim otherwise
+        violations += b.evaluate(full - 1, full + 1, &table) != full;
+    };
+    forEachPlayoutPosition(board, 32, 50, 60, checkLazy);
+
+    // Extra queens and minors from promotions widen the margin beyond what
+    // the starting material needs
+    setBoardFromFEN(board, "rn2k1nr/QQB2ppp/8/8/8/5b2/PPP3qq/RN2K1NR w - - 0 1");
+    forEachPlayoutPosition(board, 33, 50, 60, checkLazy);
+
+    std::cout << "Lazy exits: " << stats.lazyExits << " of " << stats.calls << " evaluations\n";
+    if (violations == 0 && stats.lazyExits > 0 && stats.lazyExits < stats.calls)
+        std::cout << "✅ Lazy evaluation exact inside the window, a sound bound outside\n";
+    else
+        std::cout << "❌ Lazy evaluation unsound in " << violations << " cases\n";
+}
+
+void testAttackMapEvaluation()
+{
+    printTestHeader("Mobility and King Safety");
+
+    // The attack map agrees with attackersTo() on every square
+    const std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+    int mismatches = 0;
+    for (const std::string &fen : fens)
+    {
+        Board board;
+        setBoardFromFEN(board, fen);
+        AttackMap map;
+        board.buildAttackMap(map);
+        for (int square = 0; square < 64; square++)
+        {
+            uint64_t attackers = board.attackersTo(square, board.occupied);
+            for (Color c : {WHITE, BLACK})
+                mismatches += ((map.byColor[c] >> square) & 1) != ((attackers & board.occupancy[c]) != 0);
+        }
+    }
+    if (mismatches == 0)
+        std::cout << "✅ Attack map matches attackersTo()\n";
+    else
+        std::cout << "❌ Attack map wrong on " << mismatches << " squares\n";
+
+    // King danger, measured on its own: a queen or a knight alone near the
+    // castled king is ignored; together they count (5 + 2) x 2 attackers, plus
+    // 2 for h2, which only the king defends (the rook also guards f2)
+    auto dangerTo = [](const char *fen, Color us)
+    {
+        Board board;
+        setBoardFromFEN(board, fen);
+        AttackMap map;
+        board.buildAttackMap(map);
+        return board.kingDanger(us, map);
+    };
+    int queenOnly = dangerTo("r5k1/5ppp/8/8/7q/8/5PPP/R4RK1 w - - 0 1", WHITE);
+    int knightOnly = dangerTo("r5k1/5ppp/8/8/6n1/8/5PPP/R4RK1 w - - 0 1", WHITE);
+    int both = dangerTo("r5k1/5ppp/8/8/6nq/8/5PPP/R4RK1 w - - 0 1", WHITE);
+    std::cout << "King danger: queen " << queenOnly << ", knight " << knightOnly << ", both " << both << "\n";
+    if (queenOnly == 0 && knightOnly == 0 && both == 16)
+        std::cout << "✅ King danger needs two attackers and weighs them\n";
+    else
+        std::cout << "❌ King danger wrong\n";
+
+    // Mobility, measured on its own with the pawns left in place: the bishop
+    // on c2 reaches b1 and d1 (6 - 2 = 4 below base), on e2 d1, f1, f3, g4
+    // and h5 (1 below); 5 per square in both phases
+    auto mobilityOf = [](const char *fen, Color us)
+    {
+        Board board;
+        setBoardFromFEN(board, fen);
+        AttackMap map;
+        board.buildAttackMap(map);
+        return board.mobility(us, map);
+    };
+    Score blocked = mobilityOf("4k3/8/8/8/8/1P1P4/2B5/4K3 w - - 0 1", WHITE);
+    Score freer = mobilityOf("4k3/8/8/8/8/1P1P4/4B3/4K3 w - - 0 1", WHITE);
+    std::cout << "Bishop mobility blocked: " << mgValue(blocked) << ", freer: " << mgValue(freer) << "\n";
+    if (blocked == makeScore(-20, -20) && freer == makeScore(-5, -5))
+        std::cout << "✅ Mobility counts the bishop's reachable squares\n";
+    else
+        std::cout << "❌ Mobility does not count the bishop's squares\n";
+}
+
+void testFENRoundTrip()
+{
+    printTestHeader("FEN Round Trip");
+
+    const std::string fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3",
+    };
+
+    for (const std::string &fen : fens)
+    {
+        Board board;
+        setBoardFromFEN(board, fen);
+
+        // The mailbox and occupancy caches must agree with the piece bitboards
+        uint64_t white = 0ULL, black = 0ULL;
+        for (int pt = PAWN; pt <= KING; pt++)
+        {
+            white |= board.pieces[WHITE][pt];
+            black |= board.pieces[BLACK][pt];
+        }
+        bool cachesMatch = board.occupancy[WHITE] == white && board.occupancy[BLACK] == black &&
+                           board.occupied == (white | black);
+
+        if (generateFEN(board) == fen && cachesMatch)
+            std::cout << "✅ " << fen << "\n";
+        else
+            std::cout << "❌ " << fen << " -> " << generateFEN(board) << "\n";
+    }
+}
+
+void testSliderAttacks()
+{
+    printTestHeader("Slider Attack Tables");
+
+    // Exhaustive check: every relevant occupancy of every square against the ray walker
+    bool allMatch = true;
+    for (int square = 0; square < 64 && allMatch; square++)
+    {
+        uint64_t subset = 0ULL;
+        do
+        {
+            if (bishopAttacks(square, subset) != slidingBishopAttacks(square, subset))
+                allMatch = false;
+            subset = (subset - bishopMagics[square].mask) & bishopMagics[square].mask;
+        } while (subset && allMatch);
+
+        subset = 0ULL;
+        do
+        {
+            if (rookAttacks(square, subset) != slidingRookAttacks(square, subset))
+                allMatch = false;
+            subset = (subset - rookMagics[square].mask) & rookMagics[square].mask;
+        } while (subset && allMatch);
+    }
+
+    if (allMatch)
+        std::cout << "✅ Table lookups match ray walk for all occupancies\n";
+    else
+        std::cout << "❌ Table lookup differs from ray walk\n";
+
+    // Microbenchmark: queen attacks on random occupancies
+    std::mt19937_64 rng(12345);
+    std::vector<uint64_t> occupancies(4096);
+    for (uint64_t &occ : occupancies)
+        occ = rng() & rng();
+
+    const int rounds = 64;
+    uint64_t checksumTable = 0, checksumRay = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (size_t i = 0; i < occupancies.size(); i++)
+            checksumTable ^= queenAttacks(static_cast<int>(i & 63), occupancies[i]);
+    auto mid = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        for (size_t i = 0; i < occupancies.size(); i++)
+            checksumRay ^= slidingBishopAttacks(static_cast<int>(i & 63), occupancies[i]) |
+                           slidingRookAttacks(static_cast<int>(i & 63), occupancies[i]);
+    auto end = std::chrono::steady_clock::now();
+
+    double tableNs = std::chrono::duration<double, std::nano>(mid - start).count();
+    double rayNs = std::chrono::duration<double, std::nano>(end - mid).count();
+    double lookups = static_cast<double>(rounds) * occupancies.size();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Table lookup: " << tableNs / lookups << " ns/queen\n";
+    std::cout << "Ray walk:     " << rayNs / lookups << " ns/queen\n";
+    std::cout << "Speedup:      " << rayNs / tableNs << "x\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+
+    if (checksumTable != checksumRay)
+        std::cout << "❌ Benchmark checksums differ\n";
+}
+
+void testAttackQueries()
+{
+    printTestHeader("Attack Queries");
+
+    const std::string fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    };
+
+    // Reference: look outward from each piece with the ray walker and step tables
+    for (const std::string &fen : fens)
+    {
+        Board board;
+        setBoardFromFEN(board, fen);
+
+        bool allMatch = true;
+        for (int sq = 0; sq < 64; sq++)
+        {
+            uint64_t expected = 0ULL;
+            for (int from = 0; from < 64; from++)
+            {
+                int piece = board.pieceOn[from];
+                if (!piece)
+                    continue;
+
+                uint64_t attacks = 0ULL;
+                switch (typeOf(piece))
+                {
+                case PAWN:   attacks = pawnAttacks(colorOf(piece), from); break;
+                case KNIGHT: attacks = knightAttacks(from); break;
+                case BISHOP: attacks = slidingBishopAttacks(from, board.occupied); break;
+                case ROOK:   attacks = slidingRookAttacks(from, board.occupied); break;
+                case QUEEN:  attacks = slidingBishopAttacks(from, board.occupied) |
+                                       slidingRookAttacks(from, board.occupied); break;
+                case KING:   attacks = kingAttacks(from); break;
+                }
+                if (attacks & (1ULL << sq))
+                    expected |= 1ULL << from;
+            }
+
+            if (board.attackersTo(sq, board.occupied) != expected ||
+                board.isSquareAttacked(sq, WHITE) != bool(expected & board.occupancy[WHITE]) ||
+                board.isSquareAttacked(sq, BLACK) != bool(expected & board.occupancy[BLACK]))
+                allMatch = false;
+        }
+
+        if (allMatch)
+            std::cout << "✅ " << fen << "\n";
+        else
+            std::cout << "❌ " << fen << "\n";
+    }
+
+    // Kiwipete after Qxf7+ leaves Black in check
+    Board board;
+    setBoardFromFEN(board, "r3k2r/p1ppqQb1/bn2pnp1/3PN3/1p2P3/2N4p/PPPBBPPP/R3K2R b KQkq - 0 1");
+    if (board.inCheck())
+        std::cout << "✅ Check detected\n";
+    else
+        std::cout << "❌ Check not detected\n";
+}
+
+void testStagedGeneration()
+{
+    printTestHeader("Staged Move Generation");
+
+    const std::string fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    };
+
+    // Along random playouts every stage must match a filter over the full legal list
+    int positions = 0, failures = 0;
+    auto checkStages = [&](Board &board)
+    {
+        MoveList legal, captures, quiets, evasions, quietChecks;
+        generate<LEGAL>(board, legal);
+        generate<CAPTURES>(board, captures);
+        generate<QUIETS>(board, quiets);
+        generate<EVASIONS>(board, evasions);
+        generate<QUIET_CHECKS>(board, quietChecks);
+
+        std::multiset<uint16_t> all, split, expectedChecks, checks;
+        for (Move m : legal)
+            all.insert(m.raw());
+        for (Move m : captures)
+            split.insert(m.raw());
+        for (Move m : quiets)
+            split.insert(m.raw());
+        for (Move m : quietChecks)
+            checks.insert(m.raw());
+
+        bool tacticalSplit = true;
+        for (Move m : captures)
+            tacticalSplit &= m.isCapture() || m.isPromotion();
+        for (Move m : quiets)
+        {
+            tacticalSplit &= !m.isCapture() && !m.isPromotion();
+            if (m.isCastling())
+                continue;
+            board.doMove(m);
+            if (board.inCheck())
+                expectedChecks.insert(m.raw());
+            board.undoMove();
+        }
+
+        int expectedEvasions = board.inCheck() ? legal.size() : 0;
+        if (split != all || !tacticalSplit || evasions.size() != expectedEvasions || checks != expectedChecks)
+            failures++;
+    };
+
+    for (const std::string &fen : fens)
+    {
+        Board board;
+        setBoardFromFEN(board, fen);
+        positions += forEachPlayoutPosition(board, 7, 20, 40, checkStages);
+    }
+
+    if (failures == 0)
+        std::cout << "✅ Captures, quiets, evasions and quiet checks consistent over " << positions << " positions\n";
+    else
+        std::cout << "❌ Staged generation differs from legal moves in " << failures << " positions\n";
+}
+
+void testPerftSuite()
+{
+    printTestHeader("Perft Suite");
+
+    // Standard positions exercising castling, en passant, promotions and pins
+    struct PerftCase
+    {
+        const char *name;
+        const char *fen;
+        uint64_t expected[3];
+    };
+
+    const PerftCase cases[] = {
+        {"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", {48, 2039, 97862}},
+        {"Position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", {14, 191, 2812}},
+        {"Position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", {6, 264, 9467}},
+        {"Position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", {44, 1486, 62379}},
+    };
+
+    for (const PerftCase &test : cases)
+    {
+        Board board;
+        setBoardFromFEN(board, test.fen);
+
+        bool passed = true;
+        for (int depth = 1; depth <= 3; depth++)
+        {
+            uint64_t nodes = perft(board, depth);
+            if (nodes != test.expected[depth - 1])
+            {
+                std::cout << "❌ " << test.name << " depth " << depth << ": " << nodes
+                          << " (expected " << test.expected[depth - 1] << ")\n";
+                passed = false;
+            }
+        }
+
+        if (passed)
+            std::cout << "✅ " << test.name << " correct to depth 3\n";
+    }
+}
+
+void testHashedPerft()
+{
+    printTestHeader("Hashed Perft");
+
+    struct DeepCase
+    {
+        const char *name;
+        const char *fen;
+        int depth;
+        uint64_t expected;
+    };
+
+    const DeepCase cases[] = {
+        {"Start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 6, 119060324},
+        {"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 5, 193690690},
+    };
+
+    PerftTable table(64);
+    for (const DeepCase &test : cases)
+    {
+        Board board;
+        setBoardFromFEN(board, test.fen);
+        table.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = perft(board, test.depth, table);
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << test.name << " perft(" << test.depth << ") = " << nodes << " in "
+                  << std::fixed << std::setprecision(1) << ms << " ms\n";
+        std::cout.unsetf(std::ios::fixed);
+
+        if (nodes == test.expected)
+            std::cout << "✅ " << test.name << " correct\n";
+        else
+            std::cout << "❌ " << test.name << " incorrect (expected " << test.expected << ")\n";
+    }
+}
+
+void testParallelPerft()
+{
+    printTestHeader("Parallel Perft");
+
+    Board board;
+    setBoardFromFEN(board, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+    // Fixed worker count so the split is exercised even on single-core hosts
+    const int threads = 4;
+    PerftResult result = parallelPerft(board, 4, threads);
+
+    // Each divide entry must match a serial count of the same subtree
+    bool divideMatches = true;
+    for (const auto &[move, nodes] : result.divide)
+    {
+        board.doMove(move);
+        divideMatches &= perft(board, 3) == nodes;
+        board.undoMove();
+    }
+
+    std::cout << "Kiwipete perft(4) = " << result.nodes << " on " << threads << " threads, " << std::fixed << std::setprecision(1) << result.nps() / 1e6 << " Mnps\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    if (result.nodes == 4085603 && divideMatches)
+        std::cout << "✅ Parallel perft and divide counts correct\n";
+    else
+        std::cout << "❌ Parallel perft incorrect (expected 4085603)\n";
+}
+
+void testStaticExchange()
+{
+    printTestHeader("Static Exchange Evaluation");
+
+    struct SeeCase
+    {
+        const char *name;
+        const char *fen;
+        Move move;
+        int expected;
+    };
+
+    const SeeCase cases[] = {
+        {"Undefended pawn", "1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", Move(4, 36, Move::CAPTURE), 100},
+        {"Pawn-defended pawn", "4k3/8/3p4/4p3/8/8/8/4RK2 w - - 0 1", Move(4, 36, Move::CAPTURE), -400},
+        {"X-ray rook behind rook", "4r1k1/8/8/4p3/8/8/4R3/4RK2 w - - 0 1", Move(12, 36, Move::CAPTURE), 100},
+        {"Knight for defended pawn", "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", Move(19, 36, Move::CAPTURE), -220},
+        {"King recaptures queen", "4k3/5p2/8/8/8/5Q2/8/4K3 w - - 0 1", Move(21, 53, Move::CAPTURE), -800},
+        {"King cannot recapture", "4k3/5p2/8/8/2B5/5Q2/8/4K3 w - - 0 1", Move(21, 53, Move::CAPTURE), 100},
+    };
+
+    for (const SeeCase &test : cases)
+    {
+        Board board;
+        setBoardFromFEN(board, test.fen);
+        int value = board.see(test.move);
+        if (value == test.expected)
+            std::cout << "✅ " << test.name << ": " << value << "\n";
+        else
+            std::cout << "❌ " << test.name << ": " << value << " (expected " << test.expected << ")\n";
+    }
+
+    // Quiescence sees the king's recapture that a bare depth-1 search misses
+    Board board;
+    setBoardFromFEN(board, "4k3/5p2/8/8/8/5Q2/8/4K3 w - - 0 1");
+    SearchLimits limits;
+    limits.maxDepth = 1;
+    SearchResult result = search(board, limits);
+    if (result.bestMove != Move(21, 53, Move::CAPTURE))
+        std::cout << "✅ Depth-1 search declines Qxf7 (" << result.bestMove.toUCI() << ")\n";
+    else
+        std::cout << "❌ Depth-1 search plays Qxf7\n";
+}
+
+void testMovePicker()
+{
+    printTestHeader("Move Picker");
+
+    const std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    };
+
+    // Along random playouts: isLegal() accepts exactly the generated moves among
+    // all 65536 encodings, and the pickers return each move of their set once,
+    // whatever mix of legal and bogus hash, killer and countermove they are given
+    std::mt19937 rng(11);
+    static ButterflyHistory history;
+    for (auto &side : history)
+        for (auto &from : side)
+            for (int &entry : from)
+                entry = static_cast<int>(rng() % 2001) - 1000;
+
+    int positions = 0, legalityFailures = 0, pickerFailures = 0;
+    auto checkPickers = [&](const Board &board)
+    {
+        MoveList legal, tactical;
+        generate<LEGAL>(board, legal);
+        if (board.inCheck())
+            generate<EVASIONS>(board, tactical);
+        else
+            generate<CAPTURES>(board, tactical);
+
+        std::set<uint16_t> expected, accepted;
+        for (Move m : legal)
+            expected.insert(m.raw());
+        for (int raw = 0; raw < 65536; raw++)
+        {
+            Move m((raw >> 6) & 63, raw & 63, raw >> 12);
+            if (board.isLegal(m))
+                accepted.insert(m.raw());
+        }
+        if (accepted != expected)
+            legalityFailures++;
+
+        auto candidate = [&]()
+        {
+            return rng() % 2 && !legal.empty() ? legal[static_cast<int>(rng() % legal.size())]
+                                                : Move(rng() % 64, rng() % 64, rng() % 16);
+        };
+        Move ttMove = candidate();
+        Move killers[2] = {candidate(), candidate()};
+
+        MovePicker main(board, ttMove, killers, candidate(), history);
+        std::multiset<uint16_t> picked;
+        Move first = main.next();
+        for (Move m = first; m != Move::none(); m = main.next())
+            picked.insert(m.raw());
+        if (picked != std::multiset<uint16_t>(expected.begin(), expected.end()) ||
+            (expected.count(ttMove.raw()) && first != ttMove))
+            pickerFailures++;
+
+        MovePicker qsearch(board, candidate(), history);
+        std::multiset<uint16_t> qpicked, qexpected;
+        for (Move m = qsearch.next(); m != Move::none(); m = qsearch.next())
+            qpicked.insert(m.raw());
+        for (Move m : tactical)
+            qexpected.insert(m.raw());
+        if (qpicked != qexpected)
+            pickerFailures++;
+    };
+
+    for (const std::string &fen : fens)
+    {
+        Board board;
+        setBoardFromFEN(board, fen);
+        positions += forEachPlayoutPosition(board, 12, 4, 30, checkPickers);
+    }
+
+    if (legalityFailures == 0)
+        std::cout << "✅ isLegal() matches the generator over " << positions << " positions\n";
+    else
+        std::cout << "❌ isLegal() disagrees with the generator in " << legalityFailures << " positions\n";
+
+    if (pickerFailures == 0)
+        std::cout << "✅ Pickers return every move once, hash move first\n";
+    else
+        std::cout << "❌ Picker output wrong in " << pickerFailures << " cases\n";
+}
+
+void testSearch()
+{
+    printTestHeader("Alpha-Beta Search");
+
+    struct SearchCase
+    {
+        const char *name;
+        const char *fen;
+        int depth;
+        Move expected;
+    };
+
+    const SearchCase cases[] = {
+        {"Back-rank mate", "6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1", 4, Move(0, 56)},                  // Ra8#
+        {"Hanging queen", "rnb1kbnr/pppp1ppp/8/4p1q1/3P4/2N5/PPP1PPPP/R1BQKBNR w KQkq - 0 1", 4, Move(2, 38, Move::CAPTURE)}, // Bxg5
+        {"Stalemate", "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", 4, Move::none()},
+    };
+
+    for (const SearchCase &test : cases)
+    {
+        Board board;
+        setBoardFromFEN(board, test.fen);
+
+        SearchLimits limits;
+        limits.maxDepth = test.depth;
+        SearchResult result = search(board, limits);
+
+        // Every PV move must be legal in the position it is played from
+        bool pvLegal = true;
+        for (Move move : result.pv)
+        {
+            MoveList moves;
+            generateMoves(board, moves);
+            pvLegal &= std::find(moves.begin(), moves.end(), move) != moves.end();
+            if (!pvLegal)
+                break;
+            board.doMove(move);
+        }
+
+        std::cout << test.name << ": " << (result.bestMove == Move::none() ? "(none)" : result.bestMove.toUCI())
+                  << " score " << result.score << " depth " << result.depth << " nodes " << result.nodes << "\n";
+        if (result.bestMove == test.expected && pvLegal)
+            std::cout << "✅ " << test.name << " solved\n";
+        else
+            std::cout << "❌ " << test.name << " failed\n";
+    }
+
+    // Knights out and back again repeats the start position
+    Board board;
+    bool drawBefore = board.isDraw();
+    for (Move move : {Move(6, 21), Move(62, 45), Move(21, 6), Move(45, 62)})
+        board.doMove(move);
+    if (!drawBefore && board.isDraw())
+        std::cout << "✅ Repetition detected\n";
+    else
+        std::cout << "❌ Repetition not detected\n";
+
+    // Loading a FEN into the same Board starts a new game: the shuffle above
+    // must neither count as a repetition nor be undoable
+    setBoardFromFEN(board, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 4 3");
+    if (!board.isDraw() && board.moveHistory.empty())
+        std::cout << "✅ FEN load clears the move history\n";
+    else
+        std::cout << "❌ Move history survives a FEN load\n";
+
+    // Budgets: the search must stop near the node limit and within the time limit
+    SearchLimits nodeLimit;
+    nodeLimit.maxNodes = 20000;
+    SearchResult byNodes = search(board, nodeLimit);
+
+    SearchLimits timeLimit;
+    timeLimit.moveTimeMs = 200;
+    SearchResult byTime = search(board, timeLimit);
+
+    std::cout << "Node budget: depth " << byNodes.depth << ", " << byNodes.nodes << " nodes\n";
+    std::cout << "Time budget: depth " << byTime.depth << " in " << std::fixed << std::setprecision(3)
+              << byTime.seconds << " s\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    if (byNodes.nodes <= nodeLimit.maxNodes && byNodes.bestMove != Move::none() &&
+        byTime.seconds < 0.3 && byTime.bestMove != Move::none())
+        std::cout << "✅ Node and time budgets respected\n";
+    else
+        std::cout << "❌ Search overran its budget\n";
+
+    // Lazy SMP: helpers must stop with the main thread and leave it a sound result
+    SearchLimits smpLimits;
+    smpLimits.threads = 4;
+    smpLimits.moveTimeMs = 200;
+    setBoardFromFEN(board, "6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1");
+    SearchResult mate = search(board, smpLimits);
+    setBoardFromFEN(board, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    SearchResult smp = search(board, smpLimits);
+
+    MoveList legal;
+    generateMoves(board, legal);
+    std::cout << "4 threads: depth " << smp.depth << ", " << smp.nodes << " nodes in " << std::fixed
+              << std::setprecision(3) << smp.seconds << " s\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    if (mate.bestMove == Move(0, 56) && std::find(legal.begin(), legal.end(), smp.bestMove) != legal.end() &&
+        smp.seconds < 0.3)
+        std::cout << "✅ Multi-threaded search\n";
+    else
+        std::cout << "❌ Multi-threaded search failed\n";
+}
+
+void testTranspositionTable()
+{
+    printTestHeader("Transposition Table");
+
+    TranspositionTable table(1);
+    TTData data;
+    table.store(0x123456789ABCDEFULL, Move(12, 28, Move::DOUBLE_PUSH), -31990, 7, BOUND_LOWER);
+    bool roundTrip = table.probe(0x123456789ABCDEFULL, data) && data.move == Move(12, 28, Move::DOUBLE_PUSH) &&
+                     data.score == -31990 && data.depth == 7 && data.bound == BOUND_LOWER;
+    bool miss = !table.probe(0xFEDCBA987654321ULL, data);
+
+    if (roundTrip && miss)
+        std::cout << "✅ Store/probe round trip\n";
+    else
+        std::cout << "❌ Store/probe round trip failed\n";
+
+    // Threads hammer a small table with entries derived from their keys; a torn
+    // slot must read as a miss, never as another key's data
+    std::atomic<int> corrupt{0};
+    std::atomic<uint64_t> hits{0};
+    auto hammer = [&](int seed)
+    {
+        std::mt19937_64 rng(seed);
+        TTData found;
+        for (int i = 0; i < 200000; i++)
+        {
+            uint64_t key = rng() % 50000 * 0x9E3779B97F4A7C15ULL;
+            Move move(key & 63, (key >> 6) & 63);
+            int score = static_cast<int>(key >> 48) % 30000;
+            int depth = static_cast<int>(key >> 40) & 63;
+
+            if (table.probe(key, found))
+            {
+                hits++;
+                if (found.move != move || found.score != score || found.depth != depth)
+                    corrupt++;
+            }
+            else
+                table.store(key, move, score, depth, BOUND_EXACT);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < 4; t++)
+        pool.emplace_back(hammer, t);
+    for (std::thread &thread : pool)
+        thread.join();
+
+    if (corrupt == 0 && hits > 0)
+        std::cout << "✅ Concurrent access: " << hits << " hits, no corrupt reads\n";
+    else
+        std::cout << "❌ Concurrent access: " << corrupt << " corrupt reads\n";
+
+    // hashfull() samples the first 250 buckets: one entry in each fills a
+    // quarter of their slots; entries from an earlier search do not count
+    TranspositionTable sampled(1);
+    bool emptyAtStart = sampled.hashfull() == 0;
+    for (uint64_t b = 0; b < 250; b++)
+        sampled.store(b | 1ULL << 32, Move::none(), 0, 1, BOUND_EXACT);
+    int filled = sampled.hashfull();
+    sampled.newSearch();
+    int aged = sampled.hashfull();
+    sampled.store(1ULL << 32, Move::none(), 0, 1, BOUND_EXACT);
+    int oneNew = sampled.hashfull();
+    sampled.clear();
+    if (emptyAtStart && filled == 250 && aged == 0 && oneNew == 1 && sampled.hashfull() == 0)
+        std::cout << "✅ hashfull counts current-search entries only\n";
+    else
+        std::cout << "❌ hashfull wrong: " << filled << ", " << aged << ", " << oneNew << "\n";
+
+    // Replacement within one bucket: a table under one bucket's size has
+    // exactly one, so every key below competes for the same four slots
+    TranspositionTable bucket(0);
+    const uint64_t a = 0x1111ULL, b = 0x2222ULL, c = 0x3333ULL, d = 0x4444ULL, e = 0x5555ULL;
+    auto depthOf = [&](uint64_t key)
+    {
+        TTData found;
+        return bucket.probe(key, found) ? found.depth : -1;
+    };
+
+    bucket.store(a, Move(12, 28), 10, 5, BOUND_EXACT);
+    bucket.store(b, Move::none(), 0, 1, BOUND_EXACT);
+    bucket.store(c, Move::none(), 0, 2, BOUND_EXACT);
+    bucket.store(d, Move::none(), 0, 3, BOUND_EXACT);
+    bucket.store(a, Move(6, 21), 20, 4, BOUND_EXACT);
+    bool sameKey = bucket.probe(a, data) && data.move == Move(6, 21) && data.score == 20 && data.depth == 4 &&
+                   depthOf(b) == 1 && depthOf(c) == 2 && depthOf(d) == 3;
+    if (sameKey)
+        std::cout << "✅ Same key overwrites its own slot\n";
+    else
+        std::cout << "❌ Same-key store did not overwrite in place\n";
+
+    bucket.clear();
+    bucket.store(a, Move(12, 28), 10, 10, BOUND_EXACT);
+    bucket.store(a, Move(6, 21), 20, 3, BOUND_LOWER);
+    bool keptDeep = bucket.probe(a, data) && data.depth == 10 && data.move == Move(12, 28);
+    bucket.store(a, Move(6, 21), 20, 3, BOUND_EXACT);
+    if (keptDeep && depthOf(a) == 3)
+        std::cout << "✅ Shallow bound from the same search keeps the deeper entry\n";
+    else
+        std::cout << "❌ Shallow bound replaced a deeper entry\n";
+
+    bucket.clear();
+    bucket.store(a, Move::none(), 0, 6, BOUND_EXACT);
+    bucket.newSearch();
+    bucket.store(b, Move::none(), 0, 2, BOUND_EXACT);
+    bucket.store(c, Move::none(), 0, 3, BOUND_EXACT);
+    bucket.store(d, Move::none(), 0, 4, BOUND_EXACT);
+    bucket.store(e, Move::none(), 0, 1, BOUND_EXACT);
+    if (depthOf(a) == -1 && depthOf(b) == 2 && depthOf(c) == 3 && depthOf(d) == 4 && depthOf(e) == 1)
+        std::cout << "✅ Old deep entry evicted before new shallow ones\n";
+    else
+        std::cout << "❌ Aging did not evict the old entry first\n";
+
+    // Repeated positions cost one probe instead of a subtree: searching the
+    // same position again with the table still filled is far cheaper
+    Board board;
+    SearchLimits limits;
+    limits.maxDepth = 6;
+    TT.clear();
+    uint64_t coldNodes = search(board, limits).nodes;
+    uint64_t warmNodes = search(board, limits).nodes;
+    if (warmNodes * 2 < coldNodes)
+        std::cout << "✅ Warm table: " << warmNodes << " nodes instead of " << coldNodes << " to depth 6\n";
+    else
+        std::cout << "❌ Warm table saves nothing: " << warmNodes << " vs " << coldNodes << " nodes\n";
+}
+
 void testPieceMovement(Board &board)
 {
     printTestHeader("Piece Movement");
@@ -114,27 +1115,27 @@ void testPieceMovement(Board &board)
     // Test White pawn move
     std::cout << "Testing White pawn move (e2-e4)...\n";
     board.makeMove(12, 28); // e2-e4
-    board.printBitboard(board.whitePawns);
+    board.printBitboard(board.pieces[WHITE][PAWN]);
 
     // Test Black pawn move
     std::cout << "\nTesting Black pawn move (e7-e5)...\n";
     board.makeMove(52, 36); // e7-e5
-    board.printBitboard(board.blackPawns);
+    board.printBitboard(board.pieces[BLACK][PAWN]);
 
     // Test White knight move
     std::cout << "\nTesting White knight move (Nb1-c3)...\n";
     board.makeMove(1, 16); // Nb1-c3
-    board.printBitboard(board.whiteKnights);
+    board.printBitboard(board.pieces[WHITE][KNIGHT]);
 
     // Test Black knight move
     std::cout << "\nTesting Black knight move (Ng8-f6)...\n";
     board.makeMove(62, 45); // Ng8-f6
-    board.printBitboard(board.blackKnights);
+    board.printBitboard(board.pieces[BLACK][KNIGHT]);
 
     // Test White bishop move
     std::cout << "\nTesting White bishop move (Bf1-c4)...\n";
     board.makeMove(5, 26); // Bf1-c4
-    board.printBitboard(board.whiteBishops);
+    board.printBitboard(board.pieces[WHITE][BISHOP]);
 
     // Undo all moves
     board.undoMove();
@@ -144,6 +1145,91 @@ void testPieceMovement(Board &board)
     board.undoMove();
 }
 
+void testSelectiveSearch()
+{
+    printTestHeader("Selective Search");
+
+    // A null move clears en passant, flips the side and is undone exactly
+    Board board;
+    setBoardFromFEN(board, "rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 3");
+    std::string fen = generateFEN(board);
+    uint64_t key = board.positionKey;
+    board.makeNullMove();
+    bool nullConsistent = board.positionKey == board.calculatePositionKey() && board.whiteToMove &&
+                          board.enPassantTarget == 0;
+    board.undoNullMove();
+    if (nullConsistent && board.positionKey == key && generateFEN(board) == fen)
+        std::cout << "✅ Null move round trip\n";
+    else
+        std::cout << "❌ Null move round trip failed\n";
+
+    // Repetition detection must not look past a null move: Nf3, pass, Ng1, pass
+    // reaches the start position again, but not by legal play
+    Board shuffle;
+    shuffle.doMove(Move(6, 21));
+    shuffle.makeNullMove();
+    shuffle.doMove(Move(21, 6));
+    shuffle.makeNullMove();
+    if (!shuffle.isDraw())
+        std::cout << "✅ Repetition stops at a null move\n";
+    else
+        std::cout << "❌ Repetition seen through a null move\n";
+
+    // Each feature switched off on its own, and all together, must still find
+    // the same tactics; with everything off reaching depth 6 must cost more
+    struct Variant
+    {
+        const char *name;
+        std::vector<bool SearchLimits::*> disabled;
+    };
+    const std::vector<bool SearchLimits::*> allFeatures = {
+        &SearchLimits::nullMovePruning, &SearchLimits::lateMoveReductions, &SearchLimits::futilityPruning,
+        &SearchLimits::reverseFutilityPruning, &SearchLimits::checkExtensions};
+    const Variant variants[] = {
+        {"All enabled", {}},
+        {"No null move", {&SearchLimits::nullMovePruning}},
+        {"No LMR", {&SearchLimits::lateMoveReductions}},
+        {"No futility", {&SearchLimits::futilityPruning}},
+        {"No reverse futility", {&SearchLimits::reverseFutilityPruning}},
+        {"No check extensions", {&SearchLimits::checkExtensions}},
+        {"All disabled", allFeatures},
+    };
+
+    uint64_t allEnabledNodes = 0, allDisabledNodes = 0;
+    for (const Variant &variant : variants)
+    {
+        SearchLimits limits;
+        limits.maxDepth = 4;
+        for (bool SearchLimits::*feature : variant.disabled)
+            limits.*feature = false;
+
+        setBoardFromFEN(board, "6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1");
+        bool mate = search(board, limits).bestMove == Move(0, 56);
+        setBoardFromFEN(board, "rnb1kbnr/pppp1ppp/8/4p1q1/3P4/2N5/PPP1PPPP/R1BQKBNR w KQkq - 0 1");
+        bool queen = search(board, limits).bestMove == Move(2, 38, Move::CAPTURE);
+
+        TT.clear();
+        limits.maxDepth = 6;
+        setBoardFromFEN(board, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+        uint64_t nodes = search(board, limits).nodes;
+        if (variant.disabled.empty())
+            allEnabledNodes = nodes;
+        if (variant.disabled.size() == allFeatures.size())
+            allDisabledNodes = nodes;
+
+        if (mate && queen)
+            std::cout << "✅ " << variant.name << ": tactics solved, " << nodes << " nodes to depth 6\n";
+        else
+            std::cout << "❌ " << variant.name << ": tactic missed\n";
+    }
+
+    if (allEnabledNodes < allDisabledNodes)
+        std::cout << "✅ Selective search reaches depth 6 in " << allEnabledNodes << " instead of "
+                  << allDisabledNodes << " nodes\n";
+    else
+        std::cout << "❌ Selective search does not save nodes\n";
+}
+
 int main()
 {
     try
@@ -153,7 +1239,22 @@ int main()
         // Run all tests
         testZobristConsistency(board);
         testPositionEvaluation(board);
+        testPawnStructure();
+        testLazyEvaluation();
+        testAttackMapEvaluation();
+        testFENRoundTrip();
+        testSliderAttacks();
+        testAttackQueries();
+        testStagedGeneration();
         testMoveGeneration(board);
+        testPerftSuite();
+        testHashedPerft();
+        testParallelPerft();
+        testStaticExchange();
+        testMovePicker();
+        testSearch();
+        testSelectiveSearch();
+        testTranspositionTable();
         testPieceMovement(board);
 
         // Test move validation
@@ -0,0 +1,105 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstdint>
+#include <string>
+#include "types.h"
+
+/**
+ * A move packed into 16 bits:
+ *   bits  0-5   destination square
+ *   bits  6-11  origin square
+ *   bits 12-15  flags
+ *
+ * Flag values follow the usual from-to-flags layout: bit 2 marks a capture
+ * and bit 3 marks a promotion, whose piece is stored in the two low bits
+ * as an offset from KNIGHT. Undo information lives in StateInfo, not here.
+ */
+class Move
+{
+public:
+    static constexpr int QUIET = 0;
+    static constexpr int DOUBLE_PUSH = 1;
+    static constexpr int KING_CASTLE = 2;
+    static constexpr int QUEEN_CASTLE = 3;
+    static constexpr int CAPTURE = 4;
+    static constexpr int EN_PASSANT = 5;
+    static constexpr int PROMOTION = 8;
+
+    Move() = default;
+
+    constexpr Move(int fromSquare, int toSquare, int flags = QUIET)
+        : data(static_cast<uint16_t>((flags << 12) | (fromSquare << 6) | toSquare))
+    {
+    }
+
+    // Promotion to pieceType (KNIGHT..QUEEN), optionally capturing
+    static constexpr Move promotion(int fromSquare, int toSquare, PieceType pieceType, bool capture)
+    {
+        return Move(fromSquare, toSquare, PROMOTION | (capture ? CAPTURE : 0) | (pieceType - KNIGHT));
+    }
+
+    // The all-zero move (a1a1) never occurs in play and marks "no move"
+    static constexpr Move none() { return Move(0, 0); }
+
+    constexpr int from() const { return (data >> 6) & 63; }
+    constexpr int to() const { return data & 63; }
+    constexpr int flags() const { return data >> 12; }
+
+    constexpr bool isCapture() const { return (flags() & CAPTURE) != 0; }
+    constexpr bool isPromotion() const { return (flags() & PROMOTION) != 0; }
+    constexpr bool isEnPassant() const { return flags() == EN_PASSANT; }
+    constexpr bool isCastling() const { return flags() == KING_CASTLE || flags() == QUEEN_CASTLE; }
+
+    // Piece type the pawn promotes to; only valid for promotions
+    constexpr PieceType promotionType() const { return PieceType((flags() & 3) + KNIGHT); }
+
+    constexpr uint16_t raw() const { return data; }
+
+    // Long algebraic (UCI) notation, e.g. "e2e4" or "e7e8q"
+    std::string toUCI() const
+    {
+        std::string text{char('a' + from() % 8), char('1' + from() / 8), char('a' + to() % 8), char('1' + to() / 8)};
+        if (isPromotion())
+            text += "nbrq"[promotionType() - KNIGHT];
+        return text;
+    }
+
+    constexpr bool operator==(Move other) const { return data == other.data; }
+    constexpr bool operator!=(Move other) const { return data != other.data; }
+
+private:
+    uint16_t data;
+};
+
+static_assert(sizeof(Move) == 2, "Move must stay packed into 16 bits");
+
+/**
+ * Fixed-capacity move buffer that lives on the stack.
+ * 256 exceeds the maximum number of legal moves in any chess position.
+ */
+class MoveList
+{
+public:
+    static constexpr int MAX_MOVES = 256;
+
+    void push_back(Move move) { moves[count++] = move; }
+    void clear() { count = 0; }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move &operator[](int index) { return moves[index]; }
+    Move operator[](int index) const { return moves[index]; }
+
+    Move *begin() { return moves; }
+    Move *end() { return moves + count; }
+    const Move *begin() const { return moves; }
+    const Move *end() const { return moves + count; }
+
+private:
+    Move moves[MAX_MOVES];
+    int count = 0;
+};
+
+#endif // MOVE_H
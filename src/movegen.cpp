@@ -0,0 +1,318 @@
+#include "movegen.h"
+#include "attacks.h"
+#include "bitboard.h"
+#include "board.h"
+
+namespace
+{
+    /**
+     * Pieces of either colour that are the only blocker between a slider of
+     * colour Sniper and `ksq`. Intersected with the king side's own pieces this
+     * gives the pinned pieces; with the sniper's own pieces, discovered-check
+     * candidates.
+     */
+    template <Color Sniper>
+    uint64_t sliderBlockers(const Board &board, int ksq)
+    {
+        const uint64_t *bb = board.pieces[Sniper];
+
+        uint64_t snipers = (bishopAttacks(ksq, 0ULL) & (bb[BISHOP] | bb[QUEEN])) |
+                           (rookAttacks(ksq, 0ULL) & (bb[ROOK] | bb[QUEEN]));
+        uint64_t blockers = 0ULL;
+
+        while (snipers)
+        {
+            int sniper = findLSB(snipers);
+            snipers &= (snipers - 1);
+
+            uint64_t between = betweenBB(ksq, sniper) & board.occupied;
+            if (between && !(between & (between - 1)))
+                blockers |= between;
+        }
+        return blockers;
+    }
+
+    // Adds one move per target square; the origin lies Offset squares behind each target
+    template <int Offset>
+    void addPawnMoves(uint64_t targets, int flags, MoveList &moves)
+    {
+        while (targets)
+        {
+            int to = findLSB(targets);
+            targets &= (targets - 1);
+            moves.push_back(Move(to - Offset, to, flags));
+        }
+    }
+
+    // As addPawnMoves, but each target square yields all four promotions
+    template <int Offset>
+    void addPromotions(uint64_t targets, bool capture, MoveList &moves)
+    {
+        while (targets)
+        {
+            int to = findLSB(targets);
+            targets &= (targets - 1);
+            for (PieceType pt : {QUEEN, ROOK, BISHOP, KNIGHT})
+                moves.push_back(Move::promotion(to - Offset, to, pt, capture));
+        }
+    }
+
+    /**
+     * Pushes, captures and promotions of `pawns` that land inside `targetMask`,
+     * limited to the move kinds Type asks for. Pinned pawns are passed one at a
+     * time with the pin line folded into the mask.
+     */
+    template <Color Us, GenType Type>
+    void generatePawnMoves(const Board &board, MoveList &moves, uint64_t pawns, uint64_t targetMask)
+    {
+        constexpr Color Them = ~Us;
+        constexpr int Up = (Us == WHITE) ? NORTH : SOUTH;
+        constexpr int UpEast = (Us == WHITE) ? NORTH_EAST : SOUTH_EAST;
+        constexpr int UpWest = (Us == WHITE) ? NORTH_WEST : SOUTH_WEST;
+        constexpr uint64_t DoublePushRank = (Us == WHITE) ? RANK_3_BB : RANK_6_BB;
+        constexpr uint64_t PromotionRank = (Us == WHITE) ? RANK_8_BB : RANK_1_BB;
+
+        uint64_t empty = ~board.occupied;
+        uint64_t enemies = board.occupancy[Them];
+
+        // Pushes: a double push must pass through an empty square on the third rank
+        uint64_t singlePushes = shift<Up>(pawns) & empty;
+        uint64_t doublePushes = shift<Up>(singlePushes & DoublePushRank) & empty & targetMask;
+        singlePushes &= targetMask;
+
+        uint64_t westCaptures = shift<UpWest>(pawns) & enemies & targetMask;
+        uint64_t eastCaptures = shift<UpEast>(pawns) & enemies & targetMask;
+
+        if constexpr (Type != CAPTURES)
+        {
+            addPawnMoves<Up>(singlePushes & ~PromotionRank, Move::QUIET, moves);
+            addPawnMoves<Up + Up>(doublePushes, Move::DOUBLE_PUSH, moves);
+        }
+
+        if constexpr (Type != QUIETS && Type != QUIET_CHECKS)
+        {
+            addPawnMoves<UpWest>(westCaptures & ~PromotionRank, Move::CAPTURE, moves);
+            addPawnMoves<UpEast>(eastCaptures & ~PromotionRank, Move::CAPTURE, moves);
+
+            addPromotions<Up>(singlePushes & PromotionRank, false, moves);
+            addPromotions<UpWest>(westCaptures & PromotionRank, true, moves);
+            addPromotions<UpEast>(eastCaptures & PromotionRank, true, moves);
+        }
+    }
+
+    /**
+     * En passant is checked by replaying the capture on the occupancy: removing
+     * both pawns from one rank can expose the king to a rook or queen, which no
+     * pin mask catches.
+     */
+    template <Color Us>
+    void generateEnPassant(const Board &board, MoveList &moves, int ksq, uint64_t checkMask)
+    {
+        constexpr Color Them = ~Us;
+        constexpr int Down = (Us == WHITE) ? SOUTH : NORTH;
+
+        if (!board.enPassantTarget)
+            return;
+
+        int to = findLSB(board.enPassantTarget);
+        int capSquare = to + Down;
+
+        // In check, the capture must either block on `to` or remove the checking pawn
+        if (!(checkMask & ((1ULL << to) | (1ULL << capSquare))))
+            return;
+
+        const uint64_t *them = board.pieces[Them];
+        uint64_t candidates = pawnAttacksBB<Them>(board.enPassantTarget) & board.pieces[Us][PAWN];
+
+        while (candidates)
+        {
+            int from = findLSB(candidates);
+            candidates &= (candidates - 1);
+
+            uint64_t occupied = (board.occupied ^ (1ULL << from) ^ (1ULL << capSquare)) | (1ULL << to);
+            if ((bishopAttacks(ksq, occupied) & (them[BISHOP] | them[QUEEN])) ||
+                (rookAttacks(ksq, occupied) & (them[ROOK] | them[QUEEN])))
+                continue;
+
+            moves.push_back(Move(from, to, Move::EN_PASSANT));
+        }
+    }
+
+    /**
+     * Knight and slider moves for one side landing inside `targetMask`. A piece
+     * in `discoverers` may also go anywhere off `theirKsq`'s line; every other
+     * piece is held to `checkSquares` (all squares unless generating checks).
+     */
+    template <Color Us, PieceType Pt>
+    void generatePieceMoves(const Board &board, MoveList &moves, int ksq, uint64_t pinned, uint64_t targetMask,
+                            uint64_t checkSquares = ~0ULL, uint64_t discoverers = 0ULL, int theirKsq = 0)
+    {
+        uint64_t enemy = board.occupancy[~Us];
+        uint64_t pieces = board.pieces[Us][Pt];
+
+        // A pinned knight can never leave its pin line
+        if constexpr (Pt == KNIGHT)
+            pieces &= ~pinned;
+
+        while (pieces)
+        {
+            int sq = findLSB(pieces);
+            pieces &= (pieces - 1);
+            uint64_t reach = (discoverers & (1ULL << sq)) ? (checkSquares | ~lineBB(theirKsq, sq)) : checkSquares;
+            uint64_t targets = attacksFrom<Pt>(sq, board.occupied) & targetMask & reach;
+
+            if (pinned & (1ULL << sq))
+                targets &= lineBB(ksq, sq);
+
+            while (targets)
+            {
+                int target = findLSB(targets);
+                targets &= (targets - 1);
+                moves.push_back(Move(sq, target, (enemy & (1ULL << target)) ? Move::CAPTURE : Move::QUIET));
+            }
+        }
+    }
+
+    // True if any square in `squares` is attacked by side C
+    template <Color C>
+    bool anyAttacked(const Board &board, uint64_t squares)
+    {
+        while (squares)
+        {
+            if (board.isSquareAttacked(findLSB(squares), C))
+                return true;
+            squares &= (squares - 1);
+        }
+        return false;
+    }
+
+    // Castling: rights held, path empty, and the king neither in, through nor into check
+    template <Color Us>
+    void generateCastling(const Board &board, MoveList &moves)
+    {
+        constexpr Color Them = ~Us;
+        constexpr int KingStart = (Us == WHITE) ? 4 : 60; // e1 / e8
+        constexpr uint8_t KingSideRight = (Us == WHITE) ? 0b1000 : 0b0010;
+        constexpr uint8_t QueenSideRight = (Us == WHITE) ? 0b0100 : 0b0001;
+        constexpr uint64_t KingSidePath = (1ULL << (KingStart + 1)) | (1ULL << (KingStart + 2));
+        constexpr uint64_t QueenSidePath = (1ULL << (KingStart - 1)) | (1ULL << (KingStart - 2)) |
+                                           (1ULL << (KingStart - 3));
+        constexpr uint64_t QueenSideKingPath = (1ULL << (KingStart - 1)) | (1ULL << (KingStart - 2));
+
+        if (!(board.pieces[Us][KING] & (1ULL << KingStart)))
+            return;
+
+        if ((board.castlingRights & KingSideRight) && !(board.occupied & KingSidePath) &&
+            !anyAttacked<Them>(board, KingSidePath))
+            moves.push_back(Move(KingStart, KingStart + 2, Move::KING_CASTLE));
+
+        if ((board.castlingRights & QueenSideRight) && !(board.occupied & QueenSidePath) &&
+            !anyAttacked<Them>(board, QueenSideKingPath))
+            moves.push_back(Move(KingStart, KingStart - 2, Move::QUEEN_CASTLE));
+    }
+} // anonymous namespace
+
+template <GenType Type, Color Us>
+void generate(const Board &board, MoveList &moves)
+{
+    constexpr Color Them = ~Us;
+
+    moves.clear();
+
+    uint64_t ourKing = board.pieces[Us][KING];
+    int ksq = findLSB(ourKing);
+    uint64_t checkers = board.attackersTo(ksq, board.occupied) & board.occupancy[Them];
+
+    if constexpr (Type == EVASIONS)
+        if (!checkers)
+            return;
+
+    // Squares each move kind may land on: enemy pieces for captures, empty squares for quiets
+    uint64_t landing = ~board.occupancy[Us];
+    if constexpr (Type == CAPTURES)
+        landing = board.occupancy[Them];
+    else if constexpr (Type == QUIETS || Type == QUIET_CHECKS)
+        landing = ~board.occupied;
+
+    // Quiet checks: squares from which each piece type hits their king, and our
+    // pieces whose departure uncovers one of our sliders
+    int theirKsq = findLSB(board.pieces[Them][KING]);
+    uint64_t discoverers = 0ULL;
+    uint64_t pawnChecks = ~0ULL, knightChecks = ~0ULL, bishopChecks = ~0ULL, rookChecks = ~0ULL;
+    if constexpr (Type == QUIET_CHECKS)
+    {
+        discoverers = sliderBlockers<Us>(board, theirKsq) & board.occupancy[Us];
+        pawnChecks = pawnAttacks(Them, theirKsq);
+        knightChecks = knightAttacks(theirKsq);
+        bishopChecks = bishopAttacks(theirKsq, board.occupied);
+        rookChecks = rookAttacks(theirKsq, board.occupied);
+    }
+
+    // King moves: squares attacked with our king lifted off the board are off limits.
+    // The king never gives direct check, so quiet checks only take discovering steps.
+    uint64_t occupiedWithoutKing = board.occupied ^ ourKing;
+    uint64_t kingTargets = kingAttacks(ksq) & landing;
+    if constexpr (Type == QUIET_CHECKS)
+        kingTargets &= (discoverers & ourKing) ? ~lineBB(theirKsq, ksq) : 0ULL;
+    while (kingTargets)
+    {
+        int target = findLSB(kingTargets);
+        kingTargets &= (kingTargets - 1);
+        if (board.attackersTo(target, occupiedWithoutKing) & board.occupancy[Them])
+            continue;
+        moves.push_back(Move(ksq, target, (board.occupancy[Them] & (1ULL << target)) ? Move::CAPTURE : Move::QUIET));
+    }
+
+    // Double check: only the king may move
+    if (checkers & (checkers - 1))
+        return;
+
+    // Single check: other pieces must capture the checker or block its ray
+    uint64_t checkMask = checkers ? (checkers | betweenBB(ksq, findLSB(checkers))) : ~0ULL;
+    uint64_t targetMask = checkMask & landing;
+    uint64_t pinned = sliderBlockers<Them>(board, ksq) & board.occupancy[Us];
+
+    // Unpinned pawns in bulk; pinned and discovering pawns one at a time on their own masks.
+    // Pawns sort their moves by kind themselves (a quiet promotion still counts as a capture).
+    uint64_t pawnMask = checkMask & ~board.occupancy[Us];
+    uint64_t pawns = board.pieces[Us][PAWN];
+    uint64_t singles = pawns & (pinned | discoverers);
+    generatePawnMoves<Us, Type>(board, moves, pawns & ~singles, pawnMask & pawnChecks);
+    while (singles)
+    {
+        int sq = findLSB(singles);
+        singles &= (singles - 1);
+        uint64_t mask = pawnMask;
+        if (pinned & (1ULL << sq))
+            mask &= lineBB(ksq, sq);
+        if constexpr (Type == QUIET_CHECKS)
+            mask &= (discoverers & (1ULL << sq)) ? (pawnChecks | ~lineBB(theirKsq, sq)) : pawnChecks;
+        generatePawnMoves<Us, Type>(board, moves, 1ULL << sq, mask);
+    }
+    if constexpr (Type != QUIETS && Type != QUIET_CHECKS)
+        generateEnPassant<Us>(board, moves, ksq, checkMask);
+
+    generatePieceMoves<Us, KNIGHT>(board, moves, ksq, pinned, targetMask, knightChecks, discoverers, theirKsq);
+    generatePieceMoves<Us, BISHOP>(board, moves, ksq, pinned, targetMask, bishopChecks, discoverers, theirKsq);
+    generatePieceMoves<Us, ROOK>(board, moves, ksq, pinned, targetMask, rookChecks, discoverers, theirKsq);
+    generatePieceMoves<Us, QUEEN>(board, moves, ksq, pinned, targetMask, bishopChecks | rookChecks, discoverers, theirKsq);
+
+    if constexpr (Type == QUIETS || Type == LEGAL)
+        if (!checkers)
+            generateCastling<Us>(board, moves);
+}
+
+template <GenType Type>
+void generate(const Board &board, MoveList &moves)
+{
+    if (board.whiteToMove)
+        generate<Type, WHITE>(board, moves);
+    else
+        generate<Type, BLACK>(board, moves);
+}
+
+template void generate<CAPTURES>(const Board &board, MoveList &moves);
+template void generate<QUIETS>(const Board &board, MoveList &moves);
+template void generate<EVASIONS>(const Board &board, MoveList &moves);
+template void generate<QUIET_CHECKS>(const Board &board, MoveList &moves);
+template void generate<LEGAL>(const Board &board, MoveList &moves);
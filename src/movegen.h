@@ -0,0 +1,56 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "move.h"
+#include "types.h"
+
+class Board;
+
+/**
+ * Which subset of the legal moves generate<Type>() produces.
+ *
+ * CAPTURES      captures, en passant and every promotion (quiet or capturing)
+ * QUIETS        all remaining moves: non-capturing, non-promoting moves and castling
+ * EVASIONS      every legal move when the side to move is in check; nothing otherwise
+ * QUIET_CHECKS  the QUIETS that give direct or discovered check, castling excluded
+ * LEGAL         every legal move (CAPTURES and QUIETS together)
+ *
+ * Lets a search generate captures first and skip quiet generation entirely
+ * when a capture already produces a cutoff.
+ */
+enum GenType
+{
+    CAPTURES,
+    QUIETS,
+    EVASIONS,
+    QUIET_CHECKS,
+    LEGAL
+};
+
+/**
+ * Generates the legal moves of side Us selected by Type into `moves` (which
+ * is cleared first).
+ *
+ * Legality comes from bitboard masks rather than make/test/unmake: the king
+ * avoids attacked squares, a single checker restricts other pieces to
+ * capturing or blocking it, pinned pieces stay on their pin line, and en
+ * passant is verified against discovered rank attacks. Pawn directions,
+ * promotion ranks and castling squares are compile-time constants.
+ */
+template <GenType Type, Color Us>
+void generate(const Board &board, MoveList &moves);
+
+/**
+ * Generates the moves selected by Type for the side to move; dispatches to
+ * generate<Type, Us>.
+ */
+template <GenType Type>
+void generate(const Board &board, MoveList &moves);
+
+// All legal moves of the side to move
+inline void generateMoves(const Board &board, MoveList &moves)
+{
+    generate<LEGAL>(board, moves);
+}
+
+#endif // MOVEGEN_H
@@ -0,0 +1,183 @@
+#include "movepick.h"
+#include "board.h"
+#include "movegen.h"
+#include <utility>
+
+MovePicker::MovePicker(const Board &board, Move ttMove, const Move killers[2], Move counterMove,
+                       const ButterflyHistory &history)
+    : board(board), history(history), ttMove(board.isLegal(ttMove) ? ttMove : Move::none()),
+      killers{killers[0], killers[1]}, counterMove(counterMove), stage(MAIN_TT)
+{
+}
+
+MovePicker::MovePicker(const Board &board, Move ttMove, const ButterflyHistory &history)
+    : board(board), history(history), ttMove(Move::none())
+{
+    if (board.inCheck())
+    {
+        stage = EVASION_TT;
+        if (board.isLegal(ttMove))
+            this->ttMove = ttMove;
+    }
+    else
+    {
+        stage = QSEARCH_TT;
+        if ((ttMove.isCapture() || ttMove.isPromotion()) && board.isLegal(ttMove))
+            this->ttMove = ttMove;
+    }
+}
+
+// MVV-LVA: the victim dominates, the attacker only breaks ties; a promotion
+// counts the piece it gains
+int MovePicker::captureScore(Move move) const
+{
+    int victim = board.pieceOn[move.to()];
+    int score = move.isEnPassant() ? PIECE_VALUE[PAWN] : victim ? PIECE_VALUE[typeOf(victim)] : 0;
+    if (move.isPromotion())
+        score += PIECE_VALUE[move.promotionType()];
+    return score * 8 - typeOf(board.pieceOn[move.from()]);
+}
+
+// Killers and the countermove, already tried in their own stages
+bool MovePicker::isRefutation(Move move) const
+{
+    return move == killers[0] || move == killers[1] || move == counterMove;
+}
+
+// A killer or countermove candidate is tried only if it is a legal quiet move
+// that no earlier stage has returned
+bool MovePicker::usableQuiet(Move move) const
+{
+    return move != Move::none() && move != ttMove && !move.isCapture() && !move.isPromotion() &&
+           board.isLegal(move);
+}
+
+// One pass of selection sort: swaps the best of [current, end) to the front and returns it
+Move MovePicker::selectBest()
+{
+    int best = current;
+    for (int i = current + 1; i < end; i++)
+        if (moves[i].score > moves[best].score)
+            best = i;
+    std::swap(moves[current], moves[best]);
+    return moves[current++].move;
+}
+
+Move MovePicker::next()
+{
+    MoveList list;
+    Color us = board.whiteToMove ? WHITE : BLACK;
+
+    switch (stage)
+    {
+    case MAIN_TT:
+    case QSEARCH_TT:
+    case EVASION_TT:
+        stage++;
+        if (ttMove != Move::none())
+            return ttMove;
+        return next();
+
+    case CAPTURE_INIT:
+    case QCAPTURE_INIT:
+        generate<CAPTURES>(board, list);
+        for (Move move : list)
+            moves[end++] = {move, captureScore(move)};
+        stage++;
+        return next();
+
+    case GOOD_CAPTURE:
+        while (current < end)
+        {
+            Move move = selectBest();
+            if (move == ttMove)
+                continue;
+            if (board.see(move) < 0)
+            {
+                moves[badEnd++] = moves[current - 1];
+                continue;
+            }
+            return move;
+        }
+        stage++;
+        [[fallthrough]];
+
+    case KILLER_1:
+        stage++;
+        if (usableQuiet(killers[0]))
+            return killers[0];
+        [[fallthrough]];
+
+    case KILLER_2:
+        stage++;
+        if (killers[1] != killers[0] && usableQuiet(killers[1]))
+            return killers[1];
+        [[fallthrough]];
+
+    case COUNTER_MOVE:
+        stage++;
+        if (counterMove != killers[0] && counterMove != killers[1] && usableQuiet(counterMove))
+            return counterMove;
+        [[fallthrough]];
+
+    case QUIET_INIT:
+        generate<QUIETS>(board, list);
+        current = end;
+        for (Move move : list)
+            moves[end++] = {move, history[us][move.from()][move.to()]};
+        stage++;
+        [[fallthrough]];
+
+    case QUIET:
+        while (current < end)
+        {
+            Move move = selectBest();
+            if (move != ttMove && !isRefutation(move))
+                return move;
+        }
+        stage++;
+        current = 0;
+        [[fallthrough]];
+
+    case BAD_CAPTURE:
+        if (current < badEnd)
+            return moves[current++].move;
+        break;
+
+    case QCAPTURE:
+        while (current < end)
+        {
+            Move move = selectBest();
+            if (move != ttMove)
+                return move;
+        }
+        break;
+
+    case EVASION_INIT:
+        generate<EVASIONS>(board, list);
+        for (Move move : list)
+        {
+            // Captures first, quiet evasions by history
+            int score = move.isCapture() || move.isPromotion() ? HISTORY_MAX + captureScore(move)
+                                                               : history[us][move.from()][move.to()];
+            moves[end++] = {move, score};
+        }
+        stage++;
+        [[fallthrough]];
+
+    case EVASION:
+        while (current < end)
+        {
+            Move move = selectBest();
+            if (move != ttMove)
+                return move;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    stage = DONE;
+    return Move::none();
+}
@@ -0,0 +1,100 @@
+#ifndef MOVEPICK_H
+#define MOVEPICK_H
+
+#include "move.h"
+#include "types.h"
+
+class Board;
+
+// History scores are kept within +-HISTORY_MAX
+constexpr int HISTORY_MAX = 16384;
+
+// Butterfly history: how well each quiet move, by [colour][from][to], has done in cutoffs
+using ButterflyHistory = int[2][64][64];
+
+/**
+ * Adds `bonus` (negative for a penalty) to a history entry. The update shrinks
+ * as the entry nears HISTORY_MAX, so old results fade instead of saturating.
+ */
+inline void updateHistory(int &entry, int bonus)
+{
+    int magnitude = bonus < 0 ? -bonus : bonus;
+    entry += bonus - entry * magnitude / HISTORY_MAX;
+}
+
+/**
+ * Hands out the legal moves of one position one at a time, best guess first,
+ * generating and sorting each group only when the previous one is exhausted.
+ *
+ * Main search order: the hash move, captures that do not lose material by SEE
+ * (most valuable victim, least valuable attacker first), the two killer moves,
+ * the countermove to the opponent's last move, the remaining quiets by
+ * butterfly history and finally the losing captures. Quiescence search gets
+ * the hash move and the captures and promotions only, or every evasion when in
+ * check. Each group is sorted lazily: next() selects the best remaining entry,
+ * so a cutoff after two moves pays for two scans rather than a full sort.
+ *
+ * Hash, killer and countermove candidates may be stale; they are checked with
+ * Board::isLegal() and never returned twice.
+ */
+class MovePicker
+{
+public:
+    // Main search
+    MovePicker(const Board &board, Move ttMove, const Move killers[2], Move counterMove,
+               const ButterflyHistory &history);
+
+    // Quiescence search
+    MovePicker(const Board &board, Move ttMove, const ButterflyHistory &history);
+
+    // The next move, or Move::none() once every move has been returned
+    Move next();
+
+private:
+    enum Stage
+    {
+        MAIN_TT,
+        CAPTURE_INIT,
+        GOOD_CAPTURE,
+        KILLER_1,
+        KILLER_2,
+        COUNTER_MOVE,
+        QUIET_INIT,
+        QUIET,
+        BAD_CAPTURE,
+        QSEARCH_TT,
+        QCAPTURE_INIT,
+        QCAPTURE,
+        EVASION_TT,
+        EVASION_INIT,
+        EVASION,
+        DONE
+    };
+
+    struct ScoredMove
+    {
+        Move move;
+        int score;
+    };
+
+    int captureScore(Move move) const;
+    bool isRefutation(Move move) const;
+    bool usableQuiet(Move move) const;
+    Move selectBest();
+
+    const Board &board;
+    const ButterflyHistory &history;
+    Move ttMove;
+    Move killers[2] = {Move::none(), Move::none()};
+    Move counterMove = Move::none();
+    int stage;
+
+    // Moves of the current group live in [current, end); captures that failed
+    // SEE are moved down to [0, badEnd) for the BAD_CAPTURE stage
+    ScoredMove moves[MoveList::MAX_MOVES];
+    int current = 0;
+    int end = 0;
+    int badEnd = 0;
+};
+
+#endif // MOVEPICK_H
@@ -0,0 +1,97 @@
+#include "pawns.h"
+#include "bitboard.h"
+#include "attacks.h"
+#include "board.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr Score DOUBLED = makeScore(15, 30);
+    constexpr Score ISOLATED = makeScore(10, 15);
+    constexpr Score BACKWARD = makeScore(8, 12);
+
+    // Passed pawn bonus by rank, counted from the pawn's own side
+    constexpr Score PASSED[8] = {SCORE_ZERO, makeScore(5, 10), makeScore(10, 15), makeScore(15, 25),
+                                 makeScore(25, 40), makeScore(40, 65), makeScore(60, 100), SCORE_ZERO};
+
+    uint64_t adjacentFiles(int file)
+    {
+        return (file > 0 ? FILE_A_BB << (file - 1) : 0) | (file < 7 ? FILE_A_BB << (file + 1) : 0);
+    }
+
+    // Every square on the ranks strictly in front of `rank`, as seen by colour c
+    uint64_t forwardRanks(Color c, int rank)
+    {
+        return c == WHITE ? ~0ULL << (8 * (rank + 1)) : (1ULL << (8 * rank)) - 1;
+    }
+
+    template <Color Us>
+    Score evaluateSide(const Board &board, uint64_t &passed)
+    {
+        constexpr Color Them = ~Us;
+        constexpr int Up = Us == WHITE ? NORTH : SOUTH;
+
+        uint64_t ours = board.pieces[Us][PAWN];
+        uint64_t theirs = board.pieces[Them][PAWN];
+        Score score = SCORE_ZERO;
+        passed = 0;
+
+        for (uint64_t pawns = ours; pawns; pawns &= pawns - 1)
+        {
+            int square = findLSB(pawns);
+            int file = square % 8;
+            int rank = square / 8;
+            uint64_t ahead = forwardRanks(Us, rank);
+            uint64_t fileAhead = ahead & (FILE_A_BB << file);
+            uint64_t neighbours = ours & adjacentFiles(file);
+
+            // Charged once for each pawn with a friendly pawn in front of it
+            if (ours & fileAhead)
+                score -= DOUBLED;
+
+            // Only the front pawn of a doubled pair can be passed
+            else if (!(theirs & ahead & (adjacentFiles(file) | (FILE_A_BB << file))))
+            {
+                passed |= 1ULL << square;
+                score += PASSED[Us == WHITE ? rank : 7 - rank];
+            }
+
+            if (!neighbours)
+                score -= ISOLATED;
+
+            // Backward: every neighbour has already advanced past it, so none
+            // can come to its defence, and an enemy pawn stops it advancing
+            else if (!(neighbours & ~ahead) && (pawnAttacks(Us, square + Up) & theirs))
+                score -= BACKWARD;
+        }
+        return score;
+    }
+} // anonymous namespace
+
+void evaluatePawns(const Board &board, PawnEntry &entry)
+{
+    entry.key = board.pawnKey;
+    entry.score = evaluateSide<WHITE>(board, entry.passed[WHITE]) - evaluateSide<BLACK>(board, entry.passed[BLACK]);
+}
+
+PawnTable::PawnTable(size_t entryCount)
+{
+    size_t size = 1;
+    while (size * 2 <= entryCount)
+        size *= 2;
+    entries.resize(size);
+    mask = size - 1;
+}
+
+const PawnEntry &PawnTable::probe(const Board &board)
+{
+    PawnEntry &entry = entries[board.pawnKey & mask];
+    if (entry.key != board.pawnKey)
+        evaluatePawns(board, entry);
+    return entry;
+}
+
+void PawnTable::clear()
+{
+    std::fill(entries.begin(), entries.end(), PawnEntry());
+}
@@ -0,0 +1,54 @@
+#ifndef PAWNS_H
+#define PAWNS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "types.h"
+
+class Board;
+
+// Pawn-structure evaluation of one pawn configuration
+struct PawnEntry
+{
+    // Board::pawnKey the entry was computed for
+    uint64_t key = 0;
+
+    // Doubled, isolated, backward and passed pawns, White minus Black
+    Score score = SCORE_ZERO;
+
+    // Passed pawns of each colour, for terms that also depend on pieces
+    uint64_t passed[2] = {0, 0};
+};
+
+/**
+ * Scores the pawn structure of `board` into `entry`. Every term depends on
+ * the pawns alone, so the result can be cached by pawn key.
+ */
+void evaluatePawns(const Board &board, PawnEntry &entry);
+
+/**
+ * Cache of pawn-structure evaluations indexed by Board::pawnKey. Pawn
+ * structure changes in only a small fraction of moves, so nearly every
+ * evaluation is a hit.
+ *
+ * Not thread-safe: every search thread has its own table. A fresh entry
+ * (key 0, empty structure) is already correct for the pawnless position.
+ */
+class PawnTable
+{
+public:
+    // Rounds entryCount down to a power of two
+    explicit PawnTable(size_t entryCount = 16384);
+
+    // The entry for the board's pawns, evaluated first on a miss
+    const PawnEntry &probe(const Board &board);
+
+    void clear();
+
+private:
+    std::vector<PawnEntry> entries;
+    uint64_t mask; // entries.size() - 1
+};
+
+#endif // PAWNS_H
@@ -0,0 +1,174 @@
+#include "perft.h"
+#include "board.h"
+#include "movegen.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+PerftTable::PerftTable(size_t megabytes)
+{
+    // Largest power of two that fits the budget, so a key maps to a slot with a mask
+    size_t count = 1;
+    while (count * 2 * sizeof(Entry) <= megabytes * 1024 * 1024)
+        count *= 2;
+
+    entries.resize(count);
+    mask = count - 1;
+    clear();
+}
+
+bool PerftTable::probe(uint64_t key, int depth, uint64_t &nodes) const
+{
+    const Entry &entry = entries[key & mask];
+    if (entry.key != key || entry.depth != depth)
+        return false;
+
+    nodes = entry.nodes;
+    return true;
+}
+
+void PerftTable::store(uint64_t key, int depth, uint64_t nodes)
+{
+    entries[key & mask] = {key, nodes, depth};
+}
+
+void PerftTable::clear()
+{
+    // Depth 0 is never stored, so zeroed slots cannot produce a false hit
+    std::fill(entries.begin(), entries.end(), Entry{0, 0, 0});
+}
+
+uint64_t perft(Board &board, int depth)
+{
+    if (depth == 0)
+        return 1ULL;
+
+    MoveList moves;
+    generateMoves(board, moves);
+    if (depth == 1)
+        return moves.size();
+
+    uint64_t nodes = 0;
+    for (Move move : moves)
+    {
+        board.doMove(move);
+        nodes += perft(board, depth - 1);
+        board.undoMove();
+    }
+    return nodes;
+}
+
+uint64_t perft(Board &board, int depth, PerftTable &table)
+{
+    // Below depth 2 a lookup costs about as much as bulk counting
+    if (depth < 2)
+        return perft(board, depth);
+
+    uint64_t nodes = 0;
+    if (table.probe(board.positionKey, depth, nodes))
+        return nodes;
+
+    MoveList moves;
+    generateMoves(board, moves);
+    for (Move move : moves)
+    {
+        board.doMove(move);
+        nodes += perft(board, depth - 1, table);
+        board.undoMove();
+    }
+
+    table.store(board.positionKey, depth, nodes);
+    return nodes;
+}
+
+PerftResult parallelPerft(const Board &board, int depth, int threads, size_t hashMegabytes)
+{
+    PerftResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    MoveList rootMoves;
+    generateMoves(board, rootMoves);
+    for (Move move : rootMoves)
+        result.divide.push_back({move, depth <= 1 ? 1ULL : 0ULL});
+
+    // Work items: a root move index and, from depth 3, one reply to it
+    struct WorkItem
+    {
+        int root;
+        Move reply;
+    };
+    std::vector<WorkItem> items;
+
+    if (depth >= 2)
+    {
+        Board scratch = board;
+        for (int i = 0; i < rootMoves.size(); i++)
+        {
+            if (depth == 2)
+            {
+                items.push_back({i, Move::none()});
+                continue;
+            }
+
+            scratch.doMove(rootMoves[i]);
+            MoveList replies;
+            generateMoves(scratch, replies);
+            for (Move reply : replies)
+                items.push_back({i, reply});
+            scratch.undoMove();
+        }
+    }
+
+    threads = std::max(1, std::min<int>(threads, static_cast<int>(items.size())));
+    std::atomic<size_t> nextItem{0};
+    std::vector<std::vector<uint64_t>> workerCounts(threads, std::vector<uint64_t>(rootMoves.size(), 0));
+
+    auto worker = [&](int id)
+    {
+        Board local = board;
+        std::unique_ptr<PerftTable> table;
+        if (hashMegabytes)
+            table = std::make_unique<PerftTable>(hashMegabytes);
+
+        for (size_t i = nextItem++; i < items.size(); i = nextItem++)
+        {
+            const WorkItem &item = items[i];
+            int remaining = depth - 1;
+
+            local.doMove(rootMoves[item.root]);
+            if (item.reply != Move::none())
+            {
+                local.doMove(item.reply);
+                remaining--;
+            }
+
+            uint64_t nodes = table ? perft(local, remaining, *table) : perft(local, remaining);
+            workerCounts[id][item.root] += nodes;
+
+            if (item.reply != Move::none())
+                local.undoMove();
+            local.undoMove();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int id = 1; id < threads; id++)
+        pool.emplace_back(worker, id);
+    worker(0);
+    for (std::thread &thread : pool)
+        thread.join();
+
+    for (const std::vector<uint64_t> &counts : workerCounts)
+        for (size_t i = 0; i < counts.size(); i++)
+            result.divide[i].second += counts[i];
+    for (const auto &entry : result.divide)
+        result.nodes += entry.second;
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,71 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "move.h"
+
+class Board;
+
+/**
+ * Zobrist-keyed cache of perft subtree counts.
+ *
+ * Each slot holds (key, depth, nodes); a probe hits only when both the key and
+ * the remaining depth match. Slots are always replaced, which is enough for
+ * perft's transpositions and keeps the table a flat power-of-two array.
+ */
+class PerftTable
+{
+public:
+    explicit PerftTable(size_t megabytes = 64);
+
+    bool probe(uint64_t key, int depth, uint64_t &nodes) const;
+    void store(uint64_t key, int depth, uint64_t nodes);
+    void clear();
+
+private:
+    struct Entry
+    {
+        uint64_t key;
+        uint64_t nodes;
+        int depth;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t mask; // entries.size() - 1
+};
+
+/**
+ * Counts the leaf nodes of the legal move tree to `depth`.
+ *
+ * Bulk counting: at depth 1 the size of the generated move list is returned
+ * instead of playing each move, so the last ply costs one generation call.
+ */
+uint64_t perft(Board &board, int depth);
+
+// As perft(), reusing subtree counts of transposed positions from `table`
+uint64_t perft(Board &board, int depth, PerftTable &table);
+
+// Outcome of a parallel perft run: per-root-move counts ("divide") and throughput
+struct PerftResult
+{
+    uint64_t nodes = 0;
+    std::vector<std::pair<Move, uint64_t>> divide; // in move generation order
+    double seconds = 0.0;
+
+    double nps() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+};
+
+/**
+ * Perft split across `threads` workers, each playing on its own copy of
+ * `board`. From depth 3 the work items are (root move, reply) pairs rather than
+ * root moves alone, so a few heavy root moves cannot leave most cores idle;
+ * workers pull items from a shared atomic counter. With hashMegabytes > 0 each
+ * worker also gets a private PerftTable of that size. threads <= 0 uses every
+ * hardware thread. `depth` must be at least 1.
+ */
+PerftResult parallelPerft(const Board &board, int depth, int threads, size_t hashMegabytes = 0);
+
+#endif // PERFT_H
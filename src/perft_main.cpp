@@ -0,0 +1,153 @@
+// perft_main.cpp: runs an EPD perft suite and reports correctness and speed
+//
+// Usage: perft [file.epd] [max-depth] [threads]
+//
+// Depths above max-depth (default 6; 0 for no limit) are skipped and counted
+// in the summary.
+//
+// Each EPD line is a FEN (four or six fields) followed by expected counts:
+//   rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - ;D1 20 ;D2 400
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "board.h"
+#include "fen.h"
+#include "perft.h"
+
+namespace
+{
+    struct EpdEntry
+    {
+        std::string fen;
+        std::vector<std::pair<int, uint64_t>> expected; // (depth, nodes)
+    };
+
+    std::string trim(const std::string &text)
+    {
+        size_t first = text.find_first_not_of(" \t\r\n");
+        size_t last = text.find_last_not_of(" \t\r\n");
+        return first == std::string::npos ? "" : text.substr(first, last - first + 1);
+    }
+
+    // Parses one EPD line; returns false for blank lines and comments
+    bool parseEpdLine(const std::string &line, EpdEntry &entry)
+    {
+        std::string text = trim(line);
+        if (text.empty() || text[0] == '#')
+            return false;
+
+        std::stringstream fields(text);
+        std::string field;
+        std::getline(fields, field, ';');
+        entry.fen = trim(field);
+
+        // setBoardFromFEN wants all six fields; EPD usually stops after en passant
+        std::istringstream words(entry.fen);
+        int count = 0;
+        for (std::string word; words >> word;)
+            count++;
+        if (count == 4)
+            entry.fen += " 0 1";
+
+        entry.expected.clear();
+        while (std::getline(fields, field, ';'))
+        {
+            std::istringstream op(trim(field));
+            std::string depth;
+            uint64_t nodes;
+            if (op >> depth >> nodes && depth.size() > 1 && depth[0] == 'D')
+                entry.expected.push_back({std::stoi(depth.substr(1)), nodes});
+        }
+        return true;
+    }
+
+    std::vector<EpdEntry> loadEpd(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+            throw std::runtime_error("Unable to open EPD file: " + path);
+
+        std::vector<EpdEntry> entries;
+        EpdEntry entry;
+        for (std::string line; std::getline(file, line);)
+            if (parseEpdLine(line, entry))
+                entries.push_back(entry);
+        return entries;
+    }
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "perft.epd";
+    int maxDepth = argc > 2 ? std::atoi(argv[2]) : 6;
+    if (maxDepth <= 0)
+        maxDepth = std::numeric_limits<int>::max();
+    int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    try
+    {
+        std::vector<EpdEntry> entries = loadEpd(path);
+
+        int passed = 0, failed = 0, skipped = 0;
+        uint64_t totalNodes = 0;
+        double totalSeconds = 0.0;
+
+        for (const EpdEntry &entry : entries)
+        {
+            Board board;
+            setBoardFromFEN(board, entry.fen);
+            std::cout << entry.fen << "\n";
+
+            for (const auto &[depth, expected] : entry.expected)
+            {
+                if (depth > maxDepth)
+                {
+                    std::cout << "  D" << depth << " skipped, above max depth\n";
+                    skipped++;
+                    continue;
+                }
+
+                PerftResult result = parallelPerft(board, depth, threads);
+                totalNodes += result.nodes;
+                totalSeconds += result.seconds;
+
+                bool ok = result.nodes == expected;
+                std::cout << "  D" << depth << " " << std::setw(12) << result.nodes << "  "
+                          << (ok ? "ok" : "FAIL") << "  " << std::fixed << std::setprecision(3)
+                          << result.seconds << " s\n";
+                std::cout.unsetf(std::ios::fixed);
+
+                if (ok)
+                {
+                    passed++;
+                    continue;
+                }
+
+                // Divide output pinpoints the root move whose subtree is wrong
+                failed++;
+                std::cout << "  expected " << expected << "; divide:\n";
+                for (const auto &[move, nodes] : result.divide)
+                    std::cout << "    " << move.toUCI() << ": " << nodes << "\n";
+            }
+        }
+
+        std::cout << "\n" << passed << " passed, " << failed << " failed";
+        if (skipped > 0)
+            std::cout << ", " << skipped << " skipped (raise max-depth, or 0 for all)";
+        std::cout << "\n";
+        std::cout << totalNodes << " nodes in " << std::fixed << std::setprecision(3) << totalSeconds
+                  << " s, " << std::setprecision(1)
+                  << (totalSeconds > 0.0 ? totalNodes / totalSeconds / 1e6 : 0.0) << " Mnps\n";
+        return failed == 0 ? 0 : 1;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+}
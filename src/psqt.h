@@ -0,0 +1,134 @@
+#ifndef PSQT_H
+#define PSQT_H
+
+#include "types.h"
+
+/**
+ * Piece-square tables, midgame and endgame, laid out as seen from White:
+ * the first row is rank 8, the last rank 1. Board reads them through
+ * PSQT below, never directly.
+ */
+namespace PieceSquare
+{
+    constexpr int PAWN_MG[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         10,  10,  20,  30,  30,  20,  10,  10,
+          5,   5,  10,  25,  25,  10,   5,   5,
+          0,   0,   0,  20,  20,   0,   0,   0,
+          5,  -5, -10,   0,   0, -10,  -5,   5,
+          5,  10,  10, -20, -20,  10,  10,   5,
+          0,   0,   0,   0,   0,   0,   0,   0};
+
+    // Passers decide endgames, so every step forward counts
+    constexpr int PAWN_EG[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         80,  80,  80,  80,  80,  80,  80,  80,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         30,  30,  30,  30,  30,  30,  30,  30,
+         15,  15,  15,  15,  15,  15,  15,  15,
+          5,   5,   5,   5,   5,   5,   5,   5,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0};
+
+    constexpr int KNIGHT[64] = {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50};
+
+    constexpr int BISHOP[64] = {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20};
+
+    constexpr int ROOK[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0};
+
+    constexpr int QUEEN[64] = {
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+         -5,   0,   5,   5,   5,   5,   0,  -5,
+          0,   0,   5,   5,   5,   5,   0,  -5,
+        -10,   5,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,   0,   0,   0,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20};
+
+    // Sheltered behind its pawns while queens are on
+    constexpr int KING_MG[64] = {
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20};
+
+    // Active and central once the heavy pieces are gone
+    constexpr int KING_EG[64] = {
+        -50, -40, -30, -20, -20, -30, -40, -50,
+        -30, -20, -10,   0,   0, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -30,   0,   0,   0,   0, -30, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50};
+
+    constexpr const int *MG[6] = {PAWN_MG, KNIGHT, BISHOP, ROOK, QUEEN, KING_MG};
+    constexpr const int *EG[6] = {PAWN_EG, KNIGHT, BISHOP, ROOK, QUEEN, KING_EG};
+} // namespace PieceSquare
+
+/**
+ * Material plus piece-square value, as a packed midgame/endgame Score, of
+ * every signed piece code (offset by 6, so index 0..12 covers -6..+6) on
+ * every square, from White's point of view: Black's entries are the mirrored
+ * White ones, negated. Summing the entries of all pieces on the board gives
+ * the static score that Board keeps up to date incrementally.
+ */
+struct PieceSquareTables
+{
+    Score psq[13][64];
+};
+
+constexpr PieceSquareTables makePieceSquareTables()
+{
+    PieceSquareTables tables{};
+    for (int pt = PAWN; pt <= KING; pt++)
+    {
+        int white = makePiece(WHITE, PieceType(pt)) + 6;
+        int black = makePiece(BLACK, PieceType(pt)) + 6;
+        for (int square = 0; square < 64; square++)
+        {
+            // The tables list rank 8 first: a White square maps to its vertical
+            // mirror, and Black, seeing the board from the other side, reads it as is
+            tables.psq[white][square] = makeScore(PIECE_VALUE[pt] + PieceSquare::MG[pt][square ^ 56],
+                                                  PIECE_VALUE[pt] + PieceSquare::EG[pt][square ^ 56]);
+            tables.psq[black][square] = -makeScore(PIECE_VALUE[pt] + PieceSquare::MG[pt][square],
+                                                   PIECE_VALUE[pt] + PieceSquare::EG[pt][square]);
+        }
+    }
+    return tables;
+}
+
+inline constexpr PieceSquareTables PSQT = makePieceSquareTables();
+
+#endif // PSQT_H
@@ -0,0 +1,517 @@
+#include "search.h"
+#include "tt.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    // Half-width of the first aspiration window, in centipawns
+    constexpr int ASPIRATION_DELTA = 25;
+
+    // Quiescence delta pruning: a capture is skipped when even winning the
+    // victim plus this margin cannot lift the stand-pat score to alpha
+    constexpr int DELTA_MARGIN = 200;
+
+    // Budgets are checked once per this many nodes (a power of two)
+    constexpr uint64_t CHECK_INTERVAL = 2048;
+
+    // One pawn-structure cache per search thread, kept from one search to the
+    // next like the transposition table; grown on demand, never shrunk
+    std::vector<std::unique_ptr<PawnTable>> pawnTables;
+
+    // Mate scores are stored relative to the node, not the root, so they stay
+    // correct when the position is reached again at a different ply
+    int scoreToTT(int score, int ply)
+    {
+        if (score >= VALUE_MATE_IN_MAX_PLY)
+            return score + ply;
+        if (score <= -VALUE_MATE_IN_MAX_PLY)
+            return score - ply;
+        return score;
+    }
+
+    int scoreFromTT(int score, int ply)
+    {
+        if (score >= VALUE_MATE_IN_MAX_PLY)
+            return score - ply;
+        if (score <= -VALUE_MATE_IN_MAX_PLY)
+            return score + ply;
+        return score;
+    }
+
+    // Depth skipping schedule for helper threads: helper i sits out the depths
+    // where ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) is odd
+    constexpr int SKIP_SIZE[20] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    constexpr int SKIP_PHASE[20] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+    // Reverse futility pruning: at depth <= REVERSE_FUTILITY_DEPTH a static
+    // evaluation this many centipawns per ply above beta is taken as a fail high
+    constexpr int REVERSE_FUTILITY_DEPTH = 6;
+    constexpr int REVERSE_FUTILITY_MARGIN = 80;
+
+    // Futility pruning: at depth <= FUTILITY_DEPTH, quiet moves are skipped when
+    // the static evaluation plus FUTILITY_MARGIN[depth] cannot reach alpha
+    constexpr int FUTILITY_DEPTH = 3;
+    constexpr int FUTILITY_MARGIN[FUTILITY_DEPTH + 1] = {0, 150, 300, 500};
+
+    // Null-move searches are reduced by this many plies plus one per six of depth
+    constexpr int NULL_MOVE_REDUCTION = 3;
+
+    // Late move reductions by [depth][move number], growing with the log of both
+    const auto REDUCTIONS = []
+    {
+        std::array<std::array<int, 64>, 64> table{};
+        for (int depth = 1; depth < 64; depth++)
+            for (int moveCount = 1; moveCount < 64; moveCount++)
+                table[depth][moveCount] = static_cast<int>(0.75 + std::log(depth) * std::log(moveCount) / 2.25);
+        return table;
+    }();
+
+    // Passing is rarely worse than moving except in zugzwang, which mostly
+    // arises when the mover has only king and pawns left
+    bool hasNonPawnMaterial(const Board &board, Color side)
+    {
+        return board.occupancy[side] & ~(board.pieces[side][PAWN] | board.pieces[side][KING]);
+    }
+} // anonymous namespace
+
+uint64_t SharedSearchState::totalNodes() const
+{
+    uint64_t total = 0;
+    for (const auto &worker : workers)
+        total += worker->nodeCount();
+    return total;
+}
+
+SearchWorker::SearchWorker(const Board &board, const SearchLimits &limits, int id, SharedSearchState &shared,
+                           PawnTable &pawnTable)
+    : board(board), limits(limits), id(id), shared(shared), pawnTable(pawnTable)
+{
+}
+
+bool SearchWorker::outOfBudget()
+{
+    if (stopped())
+        return true;
+
+    // Helpers simply run until the main thread tells them to stop
+    if (id != 0)
+        return false;
+
+    uint64_t searched = nodeCount();
+    if ((searched & (CHECK_INTERVAL - 1)) == 0)
+    {
+        helperNodes = shared.totalNodes() - searched;
+
+        auto elapsed = std::chrono::steady_clock::now() - shared.startTime;
+        if (limits.moveTimeMs &&
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= limits.moveTimeMs)
+            shared.stop = true;
+    }
+
+    if (limits.maxNodes && searched + helperNodes >= limits.maxNodes)
+        shared.stop = true;
+
+    return stopped();
+}
+
+// Static evaluation for the side to move; the window only matters with lazy evaluation on
+int SearchWorker::evaluate(int alpha, int beta)
+{
+    if (!limits.lazyEvaluation)
+        return board.evaluate(-VALUE_INFINITE, VALUE_INFINITE, &pawnTable, &evalStats);
+    return board.evaluate(alpha, beta, &pawnTable, &evalStats);
+}
+
+bool SearchWorker::skipDepth(int depth) const
+{
+    if (id == 0)
+        return false;
+
+    int i = (id - 1) % 20;
+    return ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2 != 0;
+}
+
+/**
+ * Resolves captures and promotions until the position is quiet, so the static
+ * evaluation is never taken in the middle of an exchange. The side to move may
+ * "stand pat" on the static score instead of capturing; captures that cannot
+ * reach alpha (delta pruning) or that lose material by SEE are never played.
+ * In check every evasion is searched, since standing pat is not an option.
+ */
+int SearchWorker::quiescence(int ply, int alpha, int beta)
+{
+    pvLength[ply] = ply;
+
+    if ((id != 0 || rootBest != Move::none()) && outOfBudget())
+        return 0;
+
+    if (board.isDraw())
+        return 0;
+
+    bool inCheck = board.inCheck();
+    if (ply >= MAX_PLY - 1)
+        return evaluate(-VALUE_INFINITE, VALUE_INFINITE);
+
+    // A lazy stand-pat is a bound on the true value that lies outside the
+    // window, so it fails high or low just as the full evaluation would
+    int standPat = -VALUE_INFINITE;
+    if (!inCheck)
+    {
+        standPat = evaluate(alpha, beta);
+        if (standPat >= beta)
+            return standPat;
+        alpha = std::max(alpha, standPat);
+    }
+
+    MovePicker picker(board, Move::none(), history);
+    int bestScore = standPat;
+    int moveCount = 0;
+    for (Move move = picker.next(); move != Move::none(); move = picker.next())
+    {
+        moveCount++;
+        if (!inCheck)
+        {
+            int victim = move.isEnPassant() ? PIECE_VALUE[PAWN]
+                         : board.pieceOn[move.to()] ? PIECE_VALUE[typeOf(board.pieceOn[move.to()])] : 0;
+            if (!move.isPromotion() && standPat + victim + DELTA_MARGIN <= alpha)
+                continue;
+            if (board.see(move) < 0)
+                continue;
+        }
+
+        board.doMove(move);
+        nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        int score = -quiescence(ply + 1, -beta, -alpha);
+        board.undoMove();
+
+        if (stopped())
+            return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score > alpha)
+            {
+                alpha = score;
+                if (alpha >= beta)
+                    break;
+            }
+        }
+    }
+
+    // Every evasion was generated, so none means checkmate
+    if (inCheck && moveCount == 0)
+        return -VALUE_MATE + ply;
+    return bestScore;
+}
+
+/**
+ * Records a quiet move that caused a beta cutoff: it becomes the first killer
+ * at this ply and the countermove to the previous move, and gains history in
+ * proportion to depth squared while the quiets tried before it lose as much.
+ */
+void SearchWorker::updateQuietStats(Move move, int ply, int depth, const MoveList &quietsTried)
+{
+    if (killers[ply][0] != move)
+    {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    Move previous = board.moveHistory.empty() ? Move::none() : board.moveHistory.back().move;
+    if (previous != Move::none())
+        counterMoves[previous.from()][previous.to()] = move;
+
+    Color us = board.whiteToMove ? WHITE : BLACK;
+    int bonus = std::min(depth * depth, HISTORY_MAX / 16);
+    updateHistory(history[us][move.from()][move.to()], bonus);
+    for (Move quiet : quietsTried)
+        updateHistory(history[us][quiet.from()][quiet.to()], -bonus);
+}
+
+/**
+ * Fail-soft alpha-beta. Non-PV nodes (null windows) may be cut short before
+ * any move is searched: by reverse futility when the static evaluation is far
+ * above beta, or by null-move pruning when passing still fails high. In the
+ * move loop, quiet moves at frontier nodes that cannot lift the evaluation to
+ * alpha are skipped, late quiet moves are searched at reduced depth and only
+ * re-searched in full if they beat alpha, and moves that give check are
+ * extended by a ply.
+ */
+int SearchWorker::negamax(int depth, int ply, int alpha, int beta)
+{
+    pvLength[ply] = ply;
+
+    // Once the main thread has a move to play, a spent budget unwinds the whole tree
+    if ((id != 0 || rootBest != Move::none()) && outOfBudget())
+        return 0;
+
+    if (ply > 0 && board.isDraw())
+        return 0;
+
+    if (depth <= 0 || ply >= MAX_PLY - 1)
+        return quiescence(ply, alpha, beta);
+
+    bool pvNode = beta - alpha > 1;
+
+    // A deep enough stored result whose bound settles this window ends the node
+    TTData tt;
+    bool ttHit = TT.probe(board.positionKey, tt);
+    if (ttHit && ply > 0 && tt.depth >= depth)
+    {
+        int ttScore = scoreFromTT(tt.score, ply);
+        if (tt.bound == BOUND_EXACT ||
+            (tt.bound == BOUND_LOWER && ttScore >= beta) ||
+            (tt.bound == BOUND_UPPER && ttScore <= alpha))
+            return ttScore;
+    }
+
+    Color us = board.whiteToMove ? WHITE : BLACK;
+    bool inCheck = board.inCheck();
+    int staticEval = inCheck ? -VALUE_INFINITE : evaluate(-VALUE_INFINITE, VALUE_INFINITE);
+    Move previous = board.moveHistory.empty() ? Move::none() : board.moveHistory.back().move;
+
+    if (!pvNode && !inCheck && ply > 0)
+    {
+        if (limits.reverseFutilityPruning && depth <= REVERSE_FUTILITY_DEPTH &&
+            staticEval - REVERSE_FUTILITY_MARGIN * depth >= beta && beta > -VALUE_MATE_IN_MAX_PLY &&
+            beta < VALUE_MATE_IN_MAX_PLY)
+            return staticEval;
+
+        // Never two null moves in a row, which would just search the same position shallower
+        if (limits.nullMovePruning && depth >= 3 && staticEval >= beta && previous != Move::none() &&
+            hasNonPawnMaterial(board, us))
+        {
+            int reduction = NULL_MOVE_REDUCTION + depth / 6;
+            board.makeNullMove();
+            nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            int score = -negamax(depth - 1 - reduction, ply + 1, -beta, -beta + 1);
+            board.undoNullMove();
+
+            if (stopped())
+                return 0;
+
+            // An unproven mate found without moving is not trusted
+            if (score >= beta)
+                return score >= VALUE_MATE_IN_MAX_PLY ? beta : score;
+        }
+    }
+
+    bool frontierFutile = limits.futilityPruning && !pvNode && !inCheck && depth <= FUTILITY_DEPTH &&
+                          staticEval + FUTILITY_MARGIN[depth] <= alpha;
+
+    Move ttMove = ply == 0 && rootBest != Move::none() ? rootBest : ttHit ? tt.move : Move::none();
+    Move counterMove = previous != Move::none() ? counterMoves[previous.from()][previous.to()] : Move::none();
+    MovePicker picker(board, ttMove, killers[ply], counterMove, history);
+
+    int originalAlpha = alpha;
+    int bestScore = -VALUE_INFINITE;
+    Move bestMove = Move::none();
+    int moveCount = 0;
+    MoveList quietsTried;
+    for (Move move = picker.next(); move != Move::none(); move = picker.next())
+    {
+        moveCount++;
+        bool quiet = !move.isCapture() && !move.isPromotion();
+
+        board.doMove(move);
+        bool givesCheck = board.inCheck();
+
+        if (frontierFutile && quiet && !givesCheck && moveCount > 1 && bestScore > -VALUE_MATE_IN_MAX_PLY)
+        {
+            board.undoMove();
+            continue;
+        }
+
+        nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // Extensions are capped so a long series of checks cannot run away
+        int extension = limits.checkExtensions && givesCheck && ply < 2 * rootDepth ? 1 : 0;
+        int newDepth = depth - 1 + extension;
+
+        // Late quiet moves rarely matter: fewer for moves with good history, more for bad
+        int reduction = 0;
+        if (limits.lateMoveReductions && depth >= 3 && moveCount > (pvNode ? 5 : 3) && quiet && !inCheck &&
+            !givesCheck)
+        {
+            reduction = REDUCTIONS[std::min(depth, 63)][std::min(moveCount, 63)];
+            reduction -= history[us][move.from()][move.to()] / (HISTORY_MAX / 2);
+            if (pvNode)
+                reduction--;
+            reduction = std::clamp(reduction, 0, newDepth - 1);
+        }
+
+        int score;
+        if (reduction > 0)
+        {
+            score = -negamax(newDepth - reduction, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha)
+                score = -negamax(newDepth, ply + 1, -beta, -alpha);
+        }
+        else
+            score = -negamax(newDepth, ply + 1, -beta, -alpha);
+        board.undoMove();
+
+        if (stopped())
+            return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score > alpha)
+            {
+                alpha = score;
+                bestMove = move;
+
+                // Extend the PV with this move and the child's line
+                pvTable[ply][ply] = move;
+                for (int i = ply + 1; i < pvLength[ply + 1]; i++)
+                    pvTable[ply][i] = pvTable[ply + 1][i];
+                pvLength[ply] = pvLength[ply + 1];
+
+                if (alpha >= beta)
+                {
+                    if (quiet)
+                        updateQuietStats(move, ply, depth, quietsTried);
+                    break;
+                }
+            }
+        }
+
+        if (quiet)
+            quietsTried.push_back(move);
+    }
+
+    if (moveCount == 0)
+        return inCheck ? -VALUE_MATE + ply : 0;
+
+    Bound bound = bestScore >= beta ? BOUND_LOWER : (bestScore > originalAlpha ? BOUND_EXACT : BOUND_UPPER);
+    TT.store(board.positionKey, bestMove, scoreToTT(bestScore, ply), depth, bound);
+    return bestScore;
+}
+
+/**
+ * Searches a narrow window around the previous score and re-searches with a
+ * doubled margin on the failing side until the score lands inside it.
+ */
+int SearchWorker::aspirationSearch(int depth, int previousScore)
+{
+    int delta = ASPIRATION_DELTA;
+    int alpha = -VALUE_INFINITE;
+    int beta = VALUE_INFINITE;
+
+    // Early iterations are too unstable for a window to pay off
+    if (depth >= 4)
+    {
+        alpha = std::max(previousScore - delta, -VALUE_INFINITE);
+        beta = std::min(previousScore + delta, VALUE_INFINITE);
+    }
+
+    while (true)
+    {
+        int score = negamax(depth, 0, alpha, beta);
+        if (stopped())
+            return score;
+
+        if (score <= alpha)
+        {
+            beta = (alpha + beta) / 2;
+            alpha = std::max(score - delta, -VALUE_INFINITE);
+        }
+        else if (score >= beta)
+            beta = std::min(score + delta, VALUE_INFINITE);
+        else
+            return score;
+
+        delta *= 2;
+    }
+}
+
+SearchResult SearchWorker::run()
+{
+    SearchResult result;
+    nodes = 0;
+    evalStats = EvalStats();
+    rootBest = Move::none();
+    std::fill(&killers[0][0], &killers[0][0] + MAX_PLY * 2, Move::none());
+    std::fill(&counterMoves[0][0], &counterMoves[0][0] + 64 * 64, Move::none());
+    std::fill(&history[0][0][0], &history[0][0][0] + 2 * 64 * 64, 0);
+
+    for (int depth = 1; depth <= limits.maxDepth; depth++)
+    {
+        if (skipDepth(depth))
+            continue;
+
+        rootDepth = depth;
+        int score = aspirationSearch(depth, result.score);
+        if (stopped())
+            break;
+
+        // Nothing to play from a mate or stalemate at the root
+        if (pvLength[0] == 0)
+        {
+            result.score = score;
+            break;
+        }
+
+        rootBest = pvTable[0][0];
+        result.bestMove = rootBest;
+        result.score = score;
+        result.depth = depth;
+        result.pv.assign(pvTable[0], pvTable[0] + pvLength[0]);
+
+        // A found mate will not get any shorter with more depth
+        if (id == 0 && std::abs(score) >= VALUE_MATE_IN_MAX_PLY)
+            break;
+
+        // Soft time limit: the next iteration would likely not finish
+        if (id == 0 && limits.moveTimeMs)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - shared.startTime;
+            if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() * 2 >= limits.moveTimeMs)
+                break;
+        }
+    }
+
+    // The main thread finishing ends the search for everyone
+    if (id == 0)
+        shared.stop = true;
+
+    result.nodes = nodeCount();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - shared.startTime).count();
+    return result;
+}
+
+SearchResult search(const Board &board, const SearchLimits &limits)
+{
+    TT.newSearch();
+
+    int threads = std::max(1, limits.threads);
+    while (static_cast<int>(pawnTables.size()) < threads)
+        pawnTables.push_back(std::make_unique<PawnTable>());
+
+    SharedSearchState shared;
+    shared.startTime = std::chrono::steady_clock::now();
+    for (int id = 0; id < threads; id++)
+        shared.workers.push_back(std::make_unique<SearchWorker>(board, limits, id, shared, *pawnTables[id]));
+
+    std::vector<std::thread> helpers;
+    for (size_t id = 1; id < shared.workers.size(); id++)
+        helpers.emplace_back([&shared, id]
+                             { shared.workers[id]->run(); });
+
+    SearchResult result = shared.workers[0]->run();
+    for (std::thread &helper : helpers)
+        helper.join();
+
+    result.nodes = shared.totalNodes();
+    for (const auto &worker : shared.workers)
+    {
+        result.evaluations += worker->evaluationStats().calls;
+        result.lazyEvaluations += worker->evaluationStats().lazyExits;
+    }
+    return result;
+}
@@ -0,0 +1,140 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "board.h"
+#include "move.h"
+#include "movepick.h"
+#include "pawns.h"
+
+// Scores are centipawns from the side to move's point of view
+constexpr int MAX_PLY = 128;
+constexpr int VALUE_INFINITE = 32001;
+constexpr int VALUE_MATE = 32000;
+constexpr int VALUE_MATE_IN_MAX_PLY = VALUE_MATE - MAX_PLY; // anything beyond is a forced mate
+
+// Budget for one search; a zero limit means unlimited
+struct SearchLimits
+{
+    int maxDepth = MAX_PLY - 1;
+    uint64_t maxNodes = 0;
+    int64_t moveTimeMs = 0;
+    int threads = 1;
+
+    // Selective search features, each switchable to measure its effect
+    bool nullMovePruning = true;
+    bool lateMoveReductions = true;
+    bool futilityPruning = true;
+    bool reverseFutilityPruning = true;
+    bool checkExtensions = true;
+
+    // Let quiescence stand-pat skip the costlier evaluation terms far outside the window
+    bool lazyEvaluation = true;
+};
+
+// Outcome of the deepest fully completed iteration
+struct SearchResult
+{
+    Move bestMove = Move::none();
+    int score = 0;
+    int depth = 0;
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+    std::vector<Move> pv;
+
+    // Static evaluations over all threads, and how many of them exited lazily
+    uint64_t evaluations = 0;
+    uint64_t lazyEvaluations = 0;
+};
+
+class SearchWorker;
+
+// What the workers of one search share besides the transposition table
+struct SharedSearchState
+{
+    std::atomic<bool> stop{false};
+    std::chrono::steady_clock::time_point startTime;
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+
+    uint64_t totalNodes() const;
+};
+
+/**
+ * Negamax alpha-beta search over one private Board copy, driven by iterative
+ * deepening with aspiration windows around the previous iteration's score.
+ *
+ * Holds all per-thread state (board, node count, principal variation table,
+ * move ordering statistics) and borrows its thread's pawn-structure cache;
+ * workers of one search share only the global transposition table and the
+ * stop flag. Worker 0 is the main thread: it alone checks the node and time
+ * budgets, every few thousand nodes, and raises the stop flag when it is
+ * done. An iteration cut short is discarded and the previous one reported.
+ */
+class SearchWorker
+{
+public:
+    SearchWorker(const Board &board, const SearchLimits &limits, int id, SharedSearchState &shared,
+                 PawnTable &pawnTable);
+
+    SearchResult run();
+
+    uint64_t nodeCount() const { return nodes.load(std::memory_order_relaxed); }
+
+    // Only meaningful once run() has returned
+    const EvalStats &evaluationStats() const { return evalStats; }
+
+private:
+    int negamax(int depth, int ply, int alpha, int beta);
+    int quiescence(int ply, int alpha, int beta);
+    int aspirationSearch(int depth, int previousScore);
+    int evaluate(int alpha, int beta);
+    void updateQuietStats(Move move, int ply, int depth, const MoveList &quietsTried);
+    bool skipDepth(int depth) const;
+    bool outOfBudget();
+    bool stopped() const { return shared.stop.load(std::memory_order_relaxed); }
+
+    Board board;
+    SearchLimits limits;
+    int id;
+    SharedSearchState &shared;
+
+    // Written only by this worker; atomic so the main thread can sum node counts
+    std::atomic<uint64_t> nodes{0};
+    uint64_t helperNodes = 0; // other workers' total as of the last budget check
+
+    // Triangular PV table: pvTable[ply] holds the line found from that ply
+    Move pvTable[MAX_PLY][MAX_PLY];
+    int pvLength[MAX_PLY];
+    Move rootBest = Move::none();
+    int rootDepth = 0;
+
+    // Move ordering statistics, reset at the start of each search: quiet moves
+    // that caused a cutoff at each ply, the quiet reply that refuted each
+    // previous move (by its from and to squares), and butterfly history
+    Move killers[MAX_PLY][2];
+    Move counterMoves[64][64];
+    ButterflyHistory history;
+
+    // Owned by search() and handed to the worker with the same id every time,
+    // so the cache stays warm across searches: pawn scores never go stale
+    PawnTable &pawnTable;
+    EvalStats evalStats;
+};
+
+/**
+ * Searches `board` within `limits` and returns the best move and its line.
+ *
+ * With limits.threads > 1 this is Lazy SMP: every thread runs the full
+ * iterative deepening on its own Board copy and they cooperate only through
+ * the shared transposition table. Helper threads skip some depths on a
+ * staggered schedule so they spread over different iterations instead of
+ * duplicating the main thread. The main thread's result is returned, with
+ * node counts summed over all threads.
+ */
+SearchResult search(const Board &board, const SearchLimits &limits);
+
+#endif // SEARCH_H
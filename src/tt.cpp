@@ -0,0 +1,122 @@
+#include "tt.h"
+#include <algorithm>
+
+TranspositionTable TT;
+
+namespace
+{
+    // Data word layout: move (16) | score (16) | depth (8) | bound (2) | age (6)
+    uint64_t pack(Move move, int score, int depth, Bound bound, uint8_t age)
+    {
+        return uint64_t(move.raw()) |
+               uint64_t(uint16_t(int16_t(score))) << 16 |
+               uint64_t(uint8_t(int8_t(depth))) << 32 |
+               uint64_t(bound) << 40 |
+               uint64_t(age) << 42;
+    }
+
+    Move packedMove(uint64_t data)
+    {
+        uint16_t raw = uint16_t(data);
+        return Move((raw >> 6) & 63, raw & 63, raw >> 12);
+    }
+
+    int packedDepth(uint64_t data) { return int8_t(data >> 32); }
+    Bound packedBound(uint64_t data) { return Bound((data >> 40) & 3); }
+    uint8_t packedAge(uint64_t data) { return uint8_t(data >> 42); }
+} // anonymous namespace
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes)
+{
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+        count *= 2;
+
+    buckets = std::vector<Bucket>(count);
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear()
+{
+    for (Bucket &bucket : buckets)
+        for (int i = 0; i < SLOTS; i++)
+        {
+            bucket.keys[i].store(0, std::memory_order_relaxed);
+            bucket.data[i].store(0, std::memory_order_relaxed);
+        }
+    generation = 0;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTData &data) const
+{
+    const Bucket &bucket = buckets[key & mask];
+    for (int i = 0; i < SLOTS; i++)
+    {
+        uint64_t word = bucket.data[i].load(std::memory_order_relaxed);
+        if ((bucket.keys[i].load(std::memory_order_relaxed) ^ word) != key || packedBound(word) == BOUND_NONE)
+            continue;
+
+        data.move = packedMove(word);
+        data.score = int16_t(word >> 16);
+        data.depth = packedDepth(word);
+        data.bound = packedBound(word);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, Move move, int score, int depth, Bound bound)
+{
+    Bucket &bucket = buckets[key & mask];
+
+    // Same position already stored, else the shallowest slot with age counting against it
+    int victim = 0;
+    int victimWorth = 1 << 30;
+    for (int i = 0; i < SLOTS; i++)
+    {
+        uint64_t word = bucket.data[i].load(std::memory_order_relaxed);
+        if ((bucket.keys[i].load(std::memory_order_relaxed) ^ word) == key)
+        {
+            // A shallower bound from this search is worth less than what is there
+            if (bound != BOUND_EXACT && packedAge(word) == generation && depth < packedDepth(word) - 2)
+                return;
+
+            // Keep a known best move when this search only produced a bound
+            if (move == Move::none())
+                move = packedMove(word);
+            victim = i;
+            break;
+        }
+
+        int relativeAge = (generation - packedAge(word)) & AGE_MASK;
+        int worth = packedDepth(word) - 8 * relativeAge;
+        if (worth < victimWorth)
+        {
+            victimWorth = worth;
+            victim = i;
+        }
+    }
+
+    uint64_t word = pack(move, score, depth, bound, generation);
+    bucket.keys[victim].store(key ^ word, std::memory_order_relaxed);
+    bucket.data[victim].store(word, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const
+{
+    int used = 0;
+    size_t sample = std::min<size_t>(buckets.size(), 250);
+    for (size_t b = 0; b < sample; b++)
+        for (int i = 0; i < SLOTS; i++)
+        {
+            uint64_t word = buckets[b].data[i].load(std::memory_order_relaxed);
+            used += packedBound(word) != BOUND_NONE && packedAge(word) == generation;
+        }
+    return static_cast<int>(used * 1000 / (sample * SLOTS));
+}
@@ -0,0 +1,79 @@
+#ifndef TT_H
+#define TT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "move.h"
+
+// How a stored score relates to the true value of the position
+enum Bound : uint8_t
+{
+    BOUND_NONE,
+    BOUND_UPPER, // failed low: true score <= stored score
+    BOUND_LOWER, // failed high: true score >= stored score
+    BOUND_EXACT
+};
+
+// Decoded contents of one table slot
+struct TTData
+{
+    Move move;
+    int score;
+    int depth;
+    Bound bound;
+};
+
+/**
+ * Fixed-size transposition table shared by every search thread.
+ *
+ * Each 64-byte, cache-line-aligned bucket holds four slots of two 64-bit
+ * words: the packed data and the position key XORed with that data. Readers
+ * and writers never lock; a slot torn by a concurrent write fails the XOR
+ * check and reads as a miss instead of returning another position's data.
+ *
+ * Within a bucket a store overwrites the slot holding the same key, otherwise
+ * the slot with the lowest depth, with entries from earlier searches (older
+ * age) replaced first.
+ */
+class TranspositionTable
+{
+public:
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    // Reallocates to the largest power-of-two bucket count within `megabytes` and clears
+    void resize(size_t megabytes);
+    void clear();
+
+    // Starts a new search generation so older entries become preferred victims
+    void newSearch() { generation = (generation + 1) & AGE_MASK; }
+
+    bool probe(uint64_t key, TTData &data) const;
+    void store(uint64_t key, Move move, int score, int depth, Bound bound);
+
+    // Pulls the bucket for `key` into cache ahead of the probe
+    void prefetch(uint64_t key) const { __builtin_prefetch(&buckets[key & mask]); }
+
+    // Permille of sampled slots written in the current search
+    int hashfull() const;
+
+private:
+    static constexpr int SLOTS = 4;
+    static constexpr uint8_t AGE_MASK = 0x3F;
+
+    struct alignas(64) Bucket
+    {
+        std::atomic<uint64_t> keys[SLOTS]; // key ^ data
+        std::atomic<uint64_t> data[SLOTS];
+    };
+    static_assert(sizeof(Bucket) == 64, "a bucket must fill exactly one cache line");
+
+    std::vector<Bucket> buckets;
+    uint64_t mask = 0; // buckets.size() - 1
+    uint8_t generation = 0;
+};
+
+extern TranspositionTable TT;
+
+#endif // TT_H
@@ -0,0 +1,94 @@
+#ifndef TYPES_H
+#define TYPES_H
+
+#include <cstdint>
+
+/**
+ * Colour and piece-type enums used to index Board::pieces[colour][type].
+ *
+ * The mailbox, findPiece() and FEN code use signed piece codes instead:
+ * +1..+6 for White pawn..king, -1..-6 for Black, 0 for an empty square.
+ * The helpers below convert between the two representations.
+ */
+enum Color
+{
+    WHITE,
+    BLACK
+};
+
+enum PieceType
+{
+    PAWN,
+    KNIGHT,
+    BISHOP,
+    ROOK,
+    QUEEN,
+    KING
+};
+
+// Material values in centipawns, for exchange evaluation and move ordering
+constexpr int PIECE_VALUE[6] = {100, 320, 330, 500, 900, 0};
+
+// Game phase: each piece's weight towards the 24 of the starting position,
+// which is pure midgame; 0 (kings and pawns only) is pure endgame
+constexpr int PHASE_WEIGHT[6] = {0, 1, 1, 2, 4, 0};
+constexpr int PHASE_MIDGAME = 24;
+
+/**
+ * A midgame and an endgame value packed into one int, so both are summed
+ * with a single addition: the endgame value sits in the upper 16 bits and
+ * the (signed) midgame value in the lower 16, with its borrow absorbed by
+ * the upper half. Only the final evaluation splits and interpolates them.
+ */
+enum Score : int
+{
+    SCORE_ZERO
+};
+
+constexpr Score makeScore(int mg, int eg)
+{
+    return Score(static_cast<int>(static_cast<unsigned>(eg) << 16) + mg);
+}
+
+constexpr int mgValue(Score score)
+{
+    return static_cast<int16_t>(static_cast<uint16_t>(static_cast<unsigned>(score)));
+}
+
+// Rounds the upper half so a negative midgame value's borrow is undone
+constexpr int egValue(Score score)
+{
+    return static_cast<int16_t>(static_cast<uint16_t>((static_cast<unsigned>(score) + 0x8000) >> 16));
+}
+
+constexpr Score operator+(Score a, Score b) { return Score(int(a) + int(b)); }
+constexpr Score operator-(Score a, Score b) { return Score(int(a) - int(b)); }
+constexpr Score operator-(Score a) { return Score(-int(a)); }
+constexpr Score operator*(Score a, int n) { return Score(int(a) * n); }
+inline Score &operator+=(Score &a, Score b) { return a = a + b; }
+inline Score &operator-=(Score &a, Score b) { return a = a - b; }
+
+constexpr Color operator~(Color c)
+{
+    return Color(c ^ BLACK);
+}
+
+// Signed piece code for a colour and type
+constexpr int makePiece(Color c, PieceType pt)
+{
+    return c == WHITE ? pt + 1 : -(pt + 1);
+}
+
+// Type of a non-empty signed piece code
+constexpr PieceType typeOf(int piece)
+{
+    return PieceType((piece < 0 ? -piece : piece) - 1);
+}
+
+// Colour of a non-empty signed piece code
+constexpr Color colorOf(int piece)
+{
+    return piece < 0 ? BLACK : WHITE;
+}
+
+#endif // TYPES_H
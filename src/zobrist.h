@@ -0,0 +1,55 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+/**
+ * Zobrist keys generated at compile time from a fixed seed, so position keys
+ * are identical across Board instances, processes and machines (persisted
+ * hash tables and opening books stay valid). Override the seed by defining
+ * VIC_ZOBRIST_SEED when compiling.
+ */
+#ifndef VIC_ZOBRIST_SEED
+#define VIC_ZOBRIST_SEED 0x7A3B1F29C4D85E61ULL
+#endif
+
+struct ZobristKeys
+{
+    uint64_t pieces[12][64]; // [piece index 0-11][square]
+    uint64_t blackToMove;
+    uint64_t castling[16]; // indexed by the 4-bit castling rights
+    uint64_t enPassant[8]; // indexed by en passant file
+};
+
+// SplitMix64: small, well-distributed and easy to evaluate in a constant expression
+constexpr uint64_t splitMix64(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr ZobristKeys makeZobristKeys(uint64_t seed)
+{
+    ZobristKeys keys{};
+    uint64_t state = seed;
+
+    for (int piece = 0; piece < 12; piece++)
+        for (int square = 0; square < 64; square++)
+            keys.pieces[piece][square] = splitMix64(state);
+
+    keys.blackToMove = splitMix64(state);
+
+    for (int i = 0; i < 16; i++)
+        keys.castling[i] = splitMix64(state);
+
+    for (int i = 0; i < 8; i++)
+        keys.enPassant[i] = splitMix64(state);
+
+    return keys;
+}
+
+inline constexpr ZobristKeys Zobrist = makeZobristKeys(VIC_ZOBRIST_SEED);
+
+#endif // ZOBRIST_H